@@ -0,0 +1,81 @@
+#include <lib/logger.hpp>
+
+#include <wpi/raw_ostream.h>
+
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+#define BENCHMARK_ITERATIONS 100000
+
+using namespace garage;
+
+static std::atomic<unsigned long> s_Allocations{0};
+
+void* operator new(std::size_t size) {
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+/**
+ * Runs the function repeatedly and reports the time and heap allocations per call
+ */
+template<typename TFunction>
+unsigned long Measure(const std::string& name, TFunction&& function) {
+    function();
+    const unsigned long allocationsBefore = s_Allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        function();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const unsigned long allocations = s_Allocations.load() - allocationsBefore;
+    wpi::errs() << name << ": " << static_cast<long>(std::chrono::duration<double, std::nano>(end - start).count() / BENCHMARK_ITERATIONS)
+                << " ns per call, " << static_cast<double>(allocations) / BENCHMARK_ITERATIONS << " allocations per call\n";
+    return allocations;
+}
+
+/**
+ * Compares the printf style formatting and subsystem prefixing with the typed thread buffer path.
+ * Exits with a failure if the typed path allocated at all, so it can guard against regressions.
+ */
+int main() {
+    // Asynchronous mode so the measurement is formatting and not the console, the background thread starts before counting
+    lib::Logger::SetLogLevel(lib::Logger::LogLevel::k_Info);
+    lib::Logger::StartAsync();
+    const std::string prefix = "[Elevator] ", controllerName = "Set Point Controller";
+    const double setPoint = 53.8;
+    const int faults = 16384;
+
+    Measure("Format then prefix", [&]() {
+        const auto log = lib::Logger::Format("Setting controller to: %s, set point %f, faults %d", FMT_STR(controllerName), setPoint, faults);
+        lib::Logger::Log(lib::Logger::LogLevel::k_Info, lib::Logger::Format("[%s] %s", "Elevator", FMT_STR(log)));
+    });
+    const unsigned long typedAllocations = Measure("Typed with prefix", [&]() {
+        lib::Logger::LogWithPrefix(lib::Logger::LogLevel::k_Info, prefix, "Setting controller to: {}, set point {}, faults {}",
+                                   controllerName, setPoint, faults);
+    });
+    // Debug is below the runtime level, so nothing should be formatted at all
+    const unsigned long disabledAllocations = Measure("Typed disabled level", [&]() {
+        lib::Logger::LogWithPrefix(lib::Logger::LogLevel::k_Debug, prefix, "Setting controller to: {}, set point {}, faults {}",
+                                   controllerName, setPoint, faults);
+    });
+
+    lib::Logger::StopAsync();
+    if (typedAllocations || disabledAllocations) {
+        wpi::errs() << "Typed logging allocated " << typedAllocations + disabledAllocations << " times, expected none\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+#include <lib/logger.hpp>
+
+#include <wpi/raw_ostream.h>
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#define BENCHMARK_ITERATIONS 20000
+#define BENCHMARK_BURST_SIZE 50 // Lines logged back to back, like a burst of sticky fault messages in one loop
+
+using namespace garage;
+
+/**
+ * Measures how long lib::Logger::Log blocks the calling thread, which is what the control loop pays.
+ * Run with standard output redirected (to a file or the console) since that is where the log lines go.
+ */
+std::vector<double> MeasureLatencies(const std::string& line) {
+    std::vector<double> latencies;
+    latencies.reserve(BENCHMARK_ITERATIONS);
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        const auto start = std::chrono::steady_clock::now();
+        lib::Logger::Log(lib::Logger::LogLevel::k_Info, line);
+        const auto end = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        // Give the background thread a chance to keep up between bursts, like the gap between control loops
+        if (i % BENCHMARK_BURST_SIZE == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    return latencies;
+}
+
+void Report(const std::string& name, const std::vector<double>& latencies) {
+    double total = 0.0;
+    for (double latency : latencies) total += latency;
+    auto percentile = [&latencies](double fraction) {
+        return latencies[static_cast<size_t>(fraction * (latencies.size() - 1))];
+    };
+    wpi::errs() << name << ": mean " << static_cast<long>(total / latencies.size())
+                << " ns, p50 " << static_cast<long>(percentile(0.5))
+                << " ns, p99 " << static_cast<long>(percentile(0.99))
+                << " ns, max " << static_cast<long>(latencies.back()) << " ns\n";
+}
+
+int main() {
+    const std::string line = "[Elevator] Sticky Faults: 16384, this is a typical length line for the robot log output";
+    lib::Logger::SetLogLevel(lib::Logger::LogLevel::k_Info);
+
+    Report("Synchronous", MeasureLatencies(line));
+
+    lib::Logger::StartAsync();
+    Report("Asynchronous", MeasureLatencies(line));
+    lib::Logger::StopAsync();
+    wpi::errs() << "Asynchronous dropped " << lib::Logger::GetDroppedCount() << " of " << BENCHMARK_ITERATIONS << " records\n";
+    return 0;
+}
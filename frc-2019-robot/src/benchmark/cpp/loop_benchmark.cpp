@@ -0,0 +1,496 @@
+#include <robot.hpp>
+
+#include <lib/clock.hpp>
+#include <lib/logger.hpp>
+#include <lib/subsystem.hpp>
+#include <lib/routine_pool.hpp>
+#include <lib/wait_routine.hpp>
+#include <lib/coroutine_routine.hpp>
+#include <lib/static_routine.hpp>
+#include <lib/routine_manager.hpp>
+#include <lib/parallel_routine.hpp>
+#include <lib/sequential_routine.hpp>
+#include <lib/auto_routine_from_csv.hpp>
+#include <lib/hardware/simulated_can.hpp>
+
+#include <routine/ball_intake_routine.hpp>
+
+#include <hal/HAL.h>
+
+#include <benchmark/benchmark.h>
+
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#define BENCHMARK_WAIT_DURATION 3600000 // Milliseconds, longer than any benchmark runs on the simulated clock
+#define BENCHMARK_AUTO_PATH "start_to_middle_left_hatch"
+
+using namespace garage;
+
+static std::atomic<unsigned long> s_Allocations{0};
+
+void* operator new(std::size_t size) {
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+/**
+ * Reports the heap allocations made while it is alive as an average per iteration
+ */
+class AllocationCounter {
+protected:
+    benchmark::State& m_State;
+    const unsigned long m_Before;
+
+public:
+    explicit AllocationCounter(benchmark::State& state) : m_State(state), m_Before(s_Allocations.load()) {}
+
+    ~AllocationCounter() {
+        m_State.counters["allocations"] = benchmark::Counter(static_cast<double>(s_Allocations.load() - m_Before),
+                                                             benchmark::Counter::kAvgIterations);
+    }
+};
+
+/**
+ * Does no work of its own so adding more of them measures what the loop spends per subsystem
+ */
+class BenchmarkSubsystem : public lib::Subsystem {
+public:
+    BenchmarkSubsystem(std::shared_ptr<Robot>& robot, const std::string& name) : Subsystem(robot, name) {}
+};
+
+// One robot for every benchmark since the HAL and the simulated devices are process wide, never destroyed
+static Robot* s_Robot = nullptr;
+static std::shared_ptr<Robot> s_RobotPointer;
+static std::shared_ptr<lib::SimulatedClock> s_Clock;
+static int s_BenchmarkSubsystemCount = 0;
+
+lib::Clock::Duration GetPeriod() {
+    return std::chrono::duration_cast<lib::Clock::Duration>(std::chrono::duration<double>(s_Robot->GetPeriod()));
+}
+
+/**
+ * One teleop loop with every CAN read taking the given microseconds, with the subsystems updated one after the other
+ * and then on the worker pool. Real time since the loop is mostly waiting.
+ */
+void BM_CanLatencyPeriodic(benchmark::State& state) {
+    lib::SimulatedCan::SetLatency(std::chrono::microseconds(state.range(0)));
+    s_Robot->SetParallelSubsystems(state.range(1) != 0);
+    const auto period = GetPeriod();
+    s_Robot->TeleopInit();
+    AllocationCounter allocationCounter(state);
+    for (auto _ : state) {
+        s_Clock->Advance(period);
+        s_Robot->ControllablePeriodic();
+    }
+    s_Robot->SetParallelSubsystems(false);
+    lib::SimulatedCan::SetLatency(std::chrono::nanoseconds(0));
+}
+
+BENCHMARK(BM_CanLatencyPeriodic)->ArgNames({"latency", "parallel"})
+        ->Args({0, 0})->Args({0, 1})->Args({50, 0})->Args({50, 1})->Args({200, 0})->Args({200, 1})
+        ->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+/**
+ * One teleop loop with the robot subsystems and the given number of extra ones. Subsystems can not be removed,
+ * so the arguments have to go up.
+ */
+void BM_ControllablePeriodic(benchmark::State& state) {
+    while (s_BenchmarkSubsystemCount < state.range(0)) {
+        s_Robot->AddSubsystem(std::make_shared<BenchmarkSubsystem>(s_RobotPointer, "Benchmark " + std::to_string(s_BenchmarkSubsystemCount++)));
+    }
+    const auto period = GetPeriod();
+    s_Robot->TeleopInit();
+    AllocationCounter allocationCounter(state);
+    for (auto _ : state) {
+        s_Clock->Advance(period);
+        s_Robot->ControllablePeriodic();
+    }
+}
+
+BENCHMARK(BM_ControllablePeriodic)->Arg(0)->Arg(4)->Arg(16)->Arg(64);
+
+/**
+ * The robot subsystems with closed loop controllers held by routines, which set them again every update
+ */
+void BM_SubsystemControl(benchmark::State& state) {
+    auto drive = s_Robot->GetSubsystem<Drive>();
+    auto elevator = s_Robot->GetSubsystem<Elevator>();
+    auto flipper = s_Robot->GetSubsystem<Flipper>();
+    const auto period = GetPeriod();
+    s_Robot->TeleopInit();
+    AllocationCounter allocationCounter(state);
+    for (auto _ : state) {
+        s_Clock->Advance(period);
+        drive->SetDriveOutput(0.0, 0.0);
+        elevator->SetWantedSetPoint(s_Robot->GetConfig().rocketMiddleHatchHeight);
+        flipper->SetAngle(FLIPPER_STOW_ANGLE);
+        drive->Periodic();
+        elevator->Periodic();
+        flipper->Periodic();
+    }
+}
+
+BENCHMARK(BM_SubsystemControl);
+
+/**
+ * A loop where the drivers asked for a routine, every subsystem reads the same command
+ */
+void BM_ReplayPeriodicWithRoutine(benchmark::State& state) {
+    const auto period = GetPeriod();
+    s_Robot->TeleopInit();
+    Command command{};
+    RoutineRequests routines{CommandRoutine::k_StowFlipper};
+    AllocationCounter allocationCounter(state);
+    for (auto _ : state) {
+        s_Clock->Advance(period);
+        s_Robot->ReplayPeriodic(command, routines);
+    }
+}
+
+BENCHMARK(BM_ReplayPeriodicWithRoutine);
+
+/**
+ * Two children per level, sequential and parallel taking turns from the root, waits at the leaves
+ */
+std::shared_ptr<lib::Routine> CreateRoutineTree(int depth) {
+    if (depth == 0) return std::make_shared<lib::WaitRoutine>(s_RobotPointer, BENCHMARK_WAIT_DURATION);
+    lib::RoutineVector children{CreateRoutineTree(depth - 1), CreateRoutineTree(depth - 1)};
+    if (depth % 2 == 0)
+        return std::make_shared<lib::SequentialRoutine>(s_RobotPointer, "Sequential", children);
+    else
+        return std::make_shared<lib::ParallelRoutine>(s_RobotPointer, "Parallel", children);
+}
+
+/**
+ * Updating an active routine tree that never finishes, so every call walks the same running branches
+ */
+void BM_RoutineManagerUpdate(benchmark::State& state) {
+    lib::RoutineManager routineManager(s_RobotPointer);
+    routineManager.AddRoutine(CreateRoutineTree(static_cast<int>(state.range(0))));
+    routineManager.Update();
+    AllocationCounter allocationCounter(state);
+    for (auto _ : state) {
+        routineManager.Update();
+    }
+}
+
+BENCHMARK(BM_RoutineManagerUpdate)->DenseRange(0, 8, 2);
+
+/**
+ * Never finishes and holds whatever subsystems it is given
+ */
+class BenchmarkRoutine : public lib::Routine {
+protected:
+    bool CheckFinished() override {
+        return false;
+    }
+
+public:
+    BenchmarkRoutine(std::shared_ptr<Robot>& robot, lib::RequirementMask requirements) : Routine(robot, "Benchmark") {
+        m_Requirements = requirements;
+    }
+};
+
+/**
+ * Routines on separate subsystems all running at once, each with another routine waiting on its subsystem.
+ * The time per routine should stay the same however many there are.
+ */
+void BM_RoutineManagerConcurrent(benchmark::State& state) {
+    const auto routineCount = static_cast<int>(state.range(0));
+    lib::RoutineManager routineManager(s_RobotPointer);
+    for (int i = 0; i < routineCount; i++) {
+        routineManager.AddRoutine(std::make_shared<BenchmarkRoutine>(s_RobotPointer, lib::RequirementMask(1) << i));
+    }
+    routineManager.Update();
+    for (int i = 0; i < routineCount; i++) {
+        routineManager.AddRoutine(std::make_shared<BenchmarkRoutine>(s_RobotPointer, lib::RequirementMask(1) << i));
+    }
+    routineManager.Update();
+    state.counters["active"] = static_cast<double>(routineManager.GetActiveRoutines().size());
+    {
+        AllocationCounter allocationCounter(state);
+        for (auto _ : state) {
+            routineManager.Update();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * routineCount);
+}
+
+BENCHMARK(BM_RoutineManagerConcurrent)->RangeMultiplier(4)->Range(1, ROUTINE_MAX_REQUIREMENTS);
+
+/**
+ * Adding routines that are already waiting, like a button held down, with the given number waiting
+ */
+void BM_RoutineManagerAddRoutine(benchmark::State& state) {
+    const auto routineCount = static_cast<std::size_t>(state.range(0));
+    lib::RoutineManager routineManager(s_RobotPointer);
+    routineManager.AddRoutine(std::make_shared<BenchmarkRoutine>(s_RobotPointer, 1));
+    routineManager.Update();
+    std::vector<std::shared_ptr<lib::Routine>> routines;
+    for (std::size_t i = 0; i < routineCount; i++) {
+        routines.push_back(std::make_shared<BenchmarkRoutine>(s_RobotPointer, 1));
+        routineManager.AddRoutine(routines.back());
+    }
+    {
+        AllocationCounter allocationCounter(state);
+        for (auto _ : state) {
+            for (auto& routine : routines) {
+                routineManager.AddRoutine(routine);
+            }
+            routineManager.Update();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * routineCount);
+}
+
+BENCHMARK(BM_RoutineManagerAddRoutine)->RangeMultiplier(4)->Range(1, ROUTINE_QUEUE_CAPACITY - 1);
+
+/**
+ * Never finishes, sleeps for a while every time it runs
+ */
+class SleepingBenchmarkRoutine : public lib::Routine {
+protected:
+    std::chrono::milliseconds m_SleepDuration;
+
+    bool CheckFinished() override {
+        SleepUntil(m_Clock->Now() + m_SleepDuration);
+        return false;
+    }
+
+public:
+    SleepingBenchmarkRoutine(std::shared_ptr<Robot>& robot, std::chrono::milliseconds sleepDuration)
+            : Routine(robot, "Sleeping Benchmark"), m_SleepDuration(sleepDuration) {}
+};
+
+/**
+ * Many routines parked in the timer wheel with wake times spread over more than a lap, plus one awake routine.
+ * The clock moves a loop each update so the wheel advances, the time should barely change with the parked count.
+ */
+void BM_RoutineManagerSleeping(benchmark::State& state) {
+    const auto routineCount = static_cast<int>(state.range(0));
+    const auto period = GetPeriod();
+    lib::RoutineManager routineManager(s_RobotPointer);
+    routineManager.AddRoutine(std::make_shared<BenchmarkRoutine>(s_RobotPointer, 0));
+    for (int i = 0; i < routineCount; i++) {
+        const std::chrono::milliseconds sleepDuration(BENCHMARK_WAIT_DURATION + i * TIMER_WHEEL_RESOLUTION * 7);
+        routineManager.AddRoutine(std::make_shared<SleepingBenchmarkRoutine>(s_RobotPointer, sleepDuration));
+        // Only so many fit in the queue at once
+        if (i % (ROUTINE_QUEUE_CAPACITY / 2) == 0) routineManager.Update();
+    }
+    routineManager.Update();
+    routineManager.Update();
+    state.counters["parked"] = static_cast<double>(routineManager.GetParkedRoutineCount());
+    {
+        AllocationCounter allocationCounter(state);
+        for (auto _ : state) {
+            s_Clock->Advance(period);
+            routineManager.Update();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * routineCount);
+}
+
+BENCHMARK(BM_RoutineManagerSleeping)->RangeMultiplier(4)->Range(16, 1024);
+
+#define BENCHMARK_STEP_COUNT 4
+
+class BenchmarkCoroutineRoutine : public lib::CoroutineRoutine {
+protected:
+    int m_Step = 0;
+
+    bool Run() override {
+        ROUTINE_BEGIN();
+        for (m_Step = 0; m_Step < BENCHMARK_STEP_COUNT; m_Step++) {
+            ROUTINE_WAIT(0);
+        }
+        ROUTINE_END();
+    }
+
+public:
+    BenchmarkCoroutineRoutine(std::shared_ptr<Robot>& robot) : CoroutineRoutine(robot, "Benchmark Coroutine") {}
+};
+
+/**
+ * Start to finish with the clock moving a period per update, the same waits as a routine tree and as a coroutine
+ */
+void RunRoutines(benchmark::State& state, lib::Routine& routine) {
+    const auto period = GetPeriod();
+    AllocationCounter allocationCounter(state);
+    for (auto _ : state) {
+        routine.Start();
+        do {
+            s_Clock->Advance(period);
+        } while (!routine.Periodic());
+    }
+}
+
+void BM_SequentialRoutineRun(benchmark::State& state) {
+    lib::RoutineVector steps;
+    for (int i = 0; i < BENCHMARK_STEP_COUNT; i++) {
+        steps.push_back(std::make_shared<lib::WaitRoutine>(s_RobotPointer, 0));
+    }
+    lib::SequentialRoutine routine(s_RobotPointer, "Benchmark Sequential", steps);
+    RunRoutines(state, routine);
+}
+
+BENCHMARK(BM_SequentialRoutineRun);
+
+void BM_CoroutineRoutineRun(benchmark::State& state) {
+    BenchmarkCoroutineRoutine routine(s_RobotPointer);
+    RunRoutines(state, routine);
+}
+
+BENCHMARK(BM_CoroutineRoutineRun);
+
+/**
+ * Sequence of a parallel pair, a wait and another parallel pair, as shared pointers and as one static tree
+ */
+void BM_DynamicRoutineTreeRun(benchmark::State& state) {
+    auto& robot = s_RobotPointer;
+    lib::SequentialRoutine routine(robot, "Benchmark Sequential", lib::RoutineVector{
+            std::make_shared<lib::ParallelRoutine>(robot, "Benchmark Parallel", lib::RoutineVector{
+                    std::make_shared<lib::WaitRoutine>(robot, 0), std::make_shared<lib::WaitRoutine>(robot, 0)}),
+            std::make_shared<lib::WaitRoutine>(robot, 0),
+            std::make_shared<lib::ParallelRoutine>(robot, "Benchmark Parallel", lib::RoutineVector{
+                    std::make_shared<lib::WaitRoutine>(robot, 0), std::make_shared<lib::WaitRoutine>(robot, 0)})
+    });
+    RunRoutines(state, routine);
+}
+
+BENCHMARK(BM_DynamicRoutineTreeRun);
+
+void BM_StaticRoutineTreeRun(benchmark::State& state) {
+    using Pair = lib::Par<lib::Wait<0>, lib::Wait<0>>;
+    auto& robot = s_RobotPointer;
+    lib::Seq<Pair, lib::Wait<0>, Pair> routine(robot, "Benchmark Sequential",
+                                               Pair(robot, "Benchmark Parallel", lib::Wait<0>(robot), lib::Wait<0>(robot)),
+                                               lib::Wait<0>(robot),
+                                               Pair(robot, "Benchmark Parallel", lib::Wait<0>(robot), lib::Wait<0>(robot)));
+    RunRoutines(state, routine);
+}
+
+BENCHMARK(BM_StaticRoutineTreeRun);
+
+/**
+ * Getting a ball intake routine for a new height and queueing it, built fresh each time and from a pool
+ */
+void BM_RoutineAllocate(benchmark::State& state) {
+    lib::RoutineManager routineManager(s_RobotPointer);
+    double height = 0.0;
+    AllocationCounter allocationCounter(state);
+    for (auto _ : state) {
+        routineManager.AddRoutine(std::make_shared<BallIntakeRoutine>(s_RobotPointer, height++, FLIPPER_UPPER_ANGLE));
+        routineManager.Reset();
+    }
+}
+
+BENCHMARK(BM_RoutineAllocate);
+
+void BM_RoutinePoolAcquire(benchmark::State& state) {
+    lib::RoutineManager routineManager(s_RobotPointer);
+    lib::RoutinePool<BallIntakeRoutine, 2> routines(s_RobotPointer, 0.0, FLIPPER_UPPER_ANGLE);
+    double height = 0.0;
+    AllocationCounter allocationCounter(state);
+    for (auto _ : state) {
+        routineManager.AddRoutine(routines.Acquire(height++, FLIPPER_UPPER_ANGLE));
+        routineManager.Reset();
+    }
+}
+
+BENCHMARK(BM_RoutinePoolAcquire);
+
+void BM_LoggerFormat(benchmark::State& state) {
+    const std::string controllerName = "Set Point Controller";
+    const double setPoint = 53.8;
+    const int faults = 16384;
+    AllocationCounter allocationCounter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lib::Logger::Format("Setting controller to: %s, set point %f, faults %d", FMT_STR(controllerName), setPoint, faults));
+    }
+}
+
+BENCHMARK(BM_LoggerFormat);
+
+/**
+ * The path is followed through the simulated drive, starting over once both followers finish
+ */
+void BM_AutoRoutineUpdate(benchmark::State& state) {
+    auto routine = std::make_shared<lib::AutoRoutineFromCSV>(s_RobotPointer, BENCHMARK_AUTO_PATH, BENCHMARK_AUTO_PATH);
+    routine->PostInitialize();
+    routine->Start();
+    AllocationCounter allocationCounter(state);
+    for (auto _ : state) {
+        routine->Periodic();
+        if (routine->IsTrajectoryFinished()) {
+            state.PauseTiming();
+            routine->Start();
+            state.ResumeTiming();
+        }
+    }
+    routine->Terminate();
+}
+
+BENCHMARK(BM_AutoRoutineUpdate);
+
+/**
+ * Each enabled robot subsystem on its own, registered at run time since which ones exist depends on the configuration
+ */
+void RegisterSubsystemBenchmarks() {
+    s_Robot->GetSubsystems().ForEach([](auto& subsystem) {
+        // Held by the robot for the whole run
+        benchmark::RegisterBenchmark(("BM_SubsystemPeriodic/" + subsystem.GetName()).c_str(), [&subsystem](benchmark::State& state) {
+            const auto period = GetPeriod();
+            AllocationCounter allocationCounter(state);
+            for (auto _ : state) {
+                s_Clock->Advance(period);
+                subsystem.Periodic();
+            }
+        });
+    });
+}
+
+/**
+ * Times the control loop and the routine framework with simulated devices on the simulated clock, and counts the heap
+ * allocations of each call. Run from the project directory so the deploy directory is found for the auto path.
+ * Takes the usual Google Benchmark flags.
+ */
+int main(int argc, char** argv) {
+    if (!HAL_Initialize(500, 0)) {
+        std::fprintf(stderr, "Could not initialize the HAL\n");
+        return EXIT_FAILURE;
+    }
+    s_Clock = std::make_shared<lib::SimulatedClock>();
+    s_Robot = new Robot;
+    auto& config = s_Robot->GetConfig();
+    // Only errors so going over the profiler phase limit with extra subsystems stays quiet
+    config.logLevel = lib::Logger::LogLevel::k_Error;
+    config.enableFlightRecorder = config.enableCommandLog = false;
+    s_Robot->SetClock(s_Clock);
+    s_Robot->RobotInit();
+    s_RobotPointer = std::shared_ptr<Robot>(s_Robot, [](Robot*) {});
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return EXIT_FAILURE;
+    RegisterSubsystemBenchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    s_Robot->DisabledInit();
+    lib::Logger::StopAsync();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,49 @@
+#include <lib/loop_profiler.hpp>
+
+#include <wpi/raw_ostream.h>
+
+#include <chrono>
+#include <string>
+
+#define BENCHMARK_ITERATIONS 1000000
+#define BENCHMARK_PHASES 24 // About what the robot registers with every subsystem enabled
+
+using namespace garage;
+
+/**
+ * Measures what one timed phase costs the control loop, with profiling on and off
+ */
+double MeasureScope(lib::LoopProfiler& profiler, int phase) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        lib::ProfilerScope scope(profiler, phase);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / BENCHMARK_ITERATIONS;
+}
+
+int main() {
+    // No network table, publishing only logs at verbose which is off
+    lib::LoopProfiler profiler;
+    profiler.Initialize(nullptr);
+    int phase = -1;
+    for (int i = 0; i < BENCHMARK_PHASES; i++) {
+        phase = profiler.AddPhase("Phase " + std::to_string(i));
+    }
+
+    const double enabled = MeasureScope(profiler, phase);
+    profiler.SetEnabled(false);
+    const double disabled = MeasureScope(profiler, phase);
+    profiler.SetEnabled(true);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < PROFILER_PUBLISH_INTERVAL; i++) {
+        profiler.EndLoop();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    wpi::errs() << "Scope enabled: " << static_cast<long>(enabled) << " ns, disabled: " << static_cast<long>(disabled) << " ns\n";
+    wpi::errs() << "Publishing " << BENCHMARK_PHASES << " phases: "
+                << static_cast<long>(std::chrono::duration<double, std::micro>(end - start).count()) << " us\n";
+    return 0;
+}
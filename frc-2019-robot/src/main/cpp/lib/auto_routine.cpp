@@ -24,7 +24,7 @@ namespace garage {
             m_Subsystem->Log(Logger::LogLevel::k_Info, "Prepared Points");
             m_TrajectorySize = trajectoryCandidate.length;
             const auto reserveLength = static_cast<const unsigned long>(m_TrajectorySize);
-            m_Subsystem->Log(Logger::LogLevel::k_Info, Logger::Format("Trajectory has %d points", reserveLength));
+            m_Subsystem->Log(Logger::LogLevel::k_Info, "Trajectory has {} points", reserveLength);
             std::vector<Segment> trajectory;
             trajectory.resize(reserveLength);
             m_LeftTrajectory.resize(reserveLength);
@@ -32,11 +32,11 @@ namespace garage {
             pathfinder_generate(&trajectoryCandidate, trajectory.data());
             m_Subsystem->Log(Logger::LogLevel::k_Info, "Generated Trajectory");
             pathfinder_modify_tank(trajectory.data(), m_TrajectorySize, m_LeftTrajectory.data(), m_RightTrajectory.data(), AUTO_WHEELBASE_DISTANCE);
-            m_Subsystem->Log(Logger::LogLevel::k_Info, Logger::Format("%d", trajectory.size()));
+            m_Subsystem->Log(Logger::LogLevel::k_Info, "{}", trajectory.size());
             m_Subsystem->Log(Logger::LogLevel::k_Info, "Modified Trajectory for Tank Drive");
             auto stop = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
-            m_Subsystem->Log(Logger::LogLevel::k_Info, Logger::Format("Path generation took %d milliseconds", duration));
+            m_Subsystem->Log(Logger::LogLevel::k_Info, "Path generation took {} milliseconds", duration);
 //            for (auto& segment : trajectory) {
 //                m_Drive->Log(Logger::LogLevel::k_Info, Logger::Format("%f, %f, %f, %f, %f, %f, %f, %f, %f",
 //                                                                      segment.dt, segment.x, segment.y, segment.position, segment.velocity,
@@ -65,31 +65,27 @@ namespace garage {
 
         void AutoRoutine::Start() {
             Routine::Start();
-            if (m_Subsystem) {
-                m_Subsystem->ResetGyroAndEncoders();
-            }
+            m_Subsystem->ResetGyroAndEncoders();
             m_LeftFollower = m_RightFollower = {0.0, 0.0, 0.0, 0, 0};
         }
 
         void AutoRoutine::Update() {
-            if (m_Subsystem) {
-                const int
-                        leftEncoder = m_Subsystem->GetDiscreteLeftEncoderTicks(), rightEncoder = m_Subsystem->GetDiscreteRightEncoderTicks();
-                const double
-                        leftOutput = pathfinder_follow_encoder(m_LeftEncoderConfig, &m_LeftFollower, m_LeftTrajectory.data(), m_TrajectorySize,
-                                                               leftEncoder),
-                        rightOutput = pathfinder_follow_encoder(m_RightEncoderConfig, &m_RightFollower, m_RightTrajectory.data(), m_TrajectorySize,
-                                                                rightEncoder),
-                        heading = m_Subsystem->GetHeading(),
-                        desiredHeading = r2d(m_LeftFollower.heading);
-                const double headingDelta = math::fixAngle(desiredHeading - heading);
-                const double turn = 0.8 * (-1.0 / 80.0) * headingDelta;
+            const int
+                    leftEncoder = m_Subsystem->GetDiscreteLeftEncoderTicks(), rightEncoder = m_Subsystem->GetDiscreteRightEncoderTicks();
+            const double
+                    leftOutput = pathfinder_follow_encoder(m_LeftEncoderConfig, &m_LeftFollower, m_LeftTrajectory.data(), m_TrajectorySize,
+                                                           leftEncoder),
+                    rightOutput = pathfinder_follow_encoder(m_RightEncoderConfig, &m_RightFollower, m_RightTrajectory.data(), m_TrajectorySize,
+                                                            rightEncoder),
+                    heading = m_Subsystem->GetHeading(),
+                    desiredHeading = r2d(m_LeftFollower.heading);
+            const double headingDelta = math::fixAngle(desiredHeading - heading);
+            const double turn = 0.8 * (-1.0 / 80.0) * headingDelta;
 //                m_Subsystem->LogSample(Logger::LogLevel::k_Debug,
 //                                       Logger::Format(
 //                                               "Left Output: %f, Right Output: %f, Left Encoder: %d, Right Encoder %d, Heading: %f, Heading Delta: %f",
 //                                               leftOutput, rightOutput, leftEncoder, rightEncoder, heading, headingDelta));
-                m_Subsystem->SetDriveOutput(leftOutput, rightOutput);
-            }
+            m_Subsystem->SetDriveOutput(leftOutput, rightOutput);
         }
 
         bool AutoRoutine::CheckFinished() {
@@ -98,9 +94,7 @@ namespace garage {
 
         void AutoRoutine::Terminate() {
             Routine::Terminate();
-            if (m_Subsystem) {
-                m_Subsystem->Unlock();
-            }
+            m_Subsystem->Unlock();
         }
     }
 }
@@ -44,15 +44,13 @@ namespace garage {
                 rewind(pathFile);
                 // CSV has a one line header
                 m_TrajectorySize = count - 1;
-                Logger::Log(Logger::LogLevel::k_Info,
-                            Logger::Format("Loaded path named: %s and path: %s with %d total segments",
-                                           FMT_STR(m_Name), FMT_STR(path), m_TrajectorySize));
+                Logger::Log(Logger::LogLevel::k_Info, "Loaded path named: {} and path: {} with {} total segments",
+                            m_Name, path, m_TrajectorySize);
                 trajectory.resize(m_TrajectorySize+1);
                 pathfinder_deserialize_csv(pathFile, trajectory.data());
                 std::fclose(pathFile);
             } else {
-                Logger::Log(Logger::LogLevel::k_Error,
-                            Logger::Format("Could not load path with name: %s and path: %s", FMT_STR(m_Name), FMT_STR(path)));
+                Logger::Log(Logger::LogLevel::k_Error, "Could not load path with name: {} and path: {}", m_Name, path);
             }
 //            for (auto& segment : trajectory) {
 //                m_Subsystem->Log(Logger::LogLevel::k_Verbose, Logger::Format("%f, %f, %f, %f, %f, %f, %f, %f, %f",
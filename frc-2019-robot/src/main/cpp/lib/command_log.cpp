@@ -0,0 +1,167 @@
+#include <lib/command_log.hpp>
+
+#include <lib/logger.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+namespace garage {
+    namespace lib {
+        CommandLog::~CommandLog() {
+            Close();
+        }
+
+        bool CommandLog::Open(const std::string& path, const std::vector<std::string>& routineNames, std::shared_ptr<Clock> clock) {
+            Close();
+            if (routineNames.size() > COMMAND_LOG_MAX_ROUTINE_NAMES) {
+                Logger::Log(Logger::LogLevel::k_Error, "[Command Log] Can only name {} routines, was given {}",
+                            COMMAND_LOG_MAX_ROUTINE_NAMES, routineNames.size());
+                return false;
+            }
+            if (!m_File.Open(path, sizeof(CommandLogHeader) + sizeof(CommandRecord) * COMMAND_LOG_CAPACITY, "Command Log")) return false;
+            m_Header = static_cast<CommandLogHeader*>(m_File.GetData());
+            m_Records = reinterpret_cast<CommandRecord*>(static_cast<char*>(m_File.GetData()) + sizeof(CommandLogHeader));
+            std::memset(m_Header, 0, sizeof(CommandLogHeader));
+            m_Header->magic = COMMAND_LOG_MAGIC;
+            m_Header->version = COMMAND_LOG_VERSION;
+            m_Header->headerSize = sizeof(CommandLogHeader);
+            m_Header->recordSize = sizeof(CommandRecord);
+            m_Header->capacity = COMMAND_LOG_CAPACITY;
+            for (std::size_t i = 0; i < routineNames.size(); i++) {
+                std::strncpy(m_Header->routineNames[i], routineNames[i].c_str(), COMMAND_LOG_NAME_SIZE - 1);
+            }
+            m_Header->routineNameCount = static_cast<uint32_t>(routineNames.size());
+            m_RoutineCount = routineNames.size();
+            m_Clock = clock;
+            m_OpenTime = m_Clock->Now();
+            m_IsNextReset = m_HasWarnedFull = m_HasWarnedRoutine = false;
+            Logger::Log(Logger::LogLevel::k_Info, "[Command Log] Recording to {}", path);
+            return true;
+        }
+
+        void CommandLog::Close() {
+            m_Header = nullptr;
+            m_Records = nullptr;
+            m_File.Close();
+        }
+
+        void CommandLog::Record(const Command& command, const RoutineRequests& routines) {
+            if (!m_Header) return;
+            const uint64_t recordCount = m_Header->recordCount;
+            if (recordCount == COMMAND_LOG_CAPACITY) {
+                if (!m_HasWarnedFull) {
+                    Logger::Log(Logger::LogLevel::k_Warning, "[Command Log] Log is full, no longer recording");
+                    m_HasWarnedFull = true;
+                }
+                return;
+            }
+            CommandRecord& record = m_Records[recordCount];
+            std::memset(&record, 0, sizeof(CommandRecord));
+            record.sequence = static_cast<uint32_t>(recordCount);
+            record.timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                    m_Clock->Now() - m_OpenTime).count());
+            record.driveForward = command.driveForward;
+            record.driveTurn = command.driveTurn;
+            record.flipper = command.flipper;
+            record.ballIntake = command.ballIntake;
+            record.elevatorInput = command.elevatorInput;
+            record.outrigger = command.outrigger;
+            record.outriggerWheel = command.outriggerWheel;
+            record.elevatorSetPoint = command.elevatorSetPoint;
+            record.flipperAngle = command.flipperAngle;
+            record.hatchIntakeDown = command.hatchIntakeDown;
+            record.offTheBooksModeEnabled = command.offTheBooksModeEnabled;
+            record.isQuickTurn = command.isQuickTurn;
+            record.terminateRoutines = command.terminateRoutines;
+            record.autoAlign = command.autoAlign;
+            record.autoAlignPressed = command.autoAlignPressed;
+            record.autoAlignReleased = command.autoAlignReleased;
+            record.hasElevatorSetPoint = command.hasElevatorSetPoint;
+            record.hasFlipperAngle = command.hasFlipperAngle;
+            record.isReset = m_IsNextReset;
+            m_IsNextReset = false;
+            for (const CommandRoutine routine : routines) {
+                const auto index = static_cast<std::size_t>(routine);
+                if (index >= m_RoutineCount || record.routineCount == COMMAND_LOG_MAX_ROUTINES) {
+                    if (!m_HasWarnedRoutine) {
+                        Logger::Log(Logger::LogLevel::k_Warning, "[Command Log] Could not record routine {}", index);
+                        m_HasWarnedRoutine = true;
+                    }
+                    continue;
+                }
+                record.routines[record.routineCount++] = static_cast<uint8_t>(index);
+            }
+            // Count the record last so a crash mid write leaves at most a half written slot past the end
+            m_Header->recordCount = recordCount + 1;
+        }
+
+        bool CommandLogReader::Open(const std::string& path, const std::vector<std::string>& routineNames) {
+            m_Records.clear();
+            std::FILE* input = std::fopen(path.c_str(), "rb");
+            if (!input) {
+                Logger::Log(Logger::LogLevel::k_Error, "[Command Log] Could not open {}: {}", path, std::strerror(errno));
+                return false;
+            }
+            // Large enough that it should not live on the stack
+            std::unique_ptr<CommandLogHeader> header = std::make_unique<CommandLogHeader>();
+            bool isValid = std::fread(header.get(), sizeof(CommandLogHeader), 1, input) == 1;
+            isValid = isValid && header->magic == COMMAND_LOG_MAGIC && header->version == COMMAND_LOG_VERSION &&
+                      header->headerSize == sizeof(CommandLogHeader) && header->recordSize == sizeof(CommandRecord) &&
+                      header->routineNameCount <= COMMAND_LOG_MAX_ROUTINE_NAMES && header->recordCount <= header->capacity;
+            if (!isValid) {
+                Logger::Log(Logger::LogLevel::k_Error, "[Command Log] {} is not a version {} command log", path, COMMAND_LOG_VERSION);
+                std::fclose(input);
+                return false;
+            }
+            bool routinesMatch = header->routineNameCount == routineNames.size();
+            for (std::size_t i = 0; routinesMatch && i < routineNames.size(); i++) {
+                header->routineNames[i][COMMAND_LOG_NAME_SIZE - 1] = '\0';
+                routinesMatch = routineNames[i].compare(0, COMMAND_LOG_NAME_SIZE - 1, header->routineNames[i]) == 0;
+            }
+            if (!routinesMatch) {
+                Logger::Log(Logger::LogLevel::k_Error, "[Command Log] Routines in {} do not match the robot, it was recorded with different code", path);
+                std::fclose(input);
+                return false;
+            }
+            m_Records.resize(static_cast<std::size_t>(header->recordCount));
+            const std::size_t readCount = std::fread(m_Records.data(), sizeof(CommandRecord), m_Records.size(), input);
+            std::fclose(input);
+            if (readCount != m_Records.size()) {
+                Logger::Log(Logger::LogLevel::k_Warning, "[Command Log] {} is cut short, only read {} of {} records", path, readCount, m_Records.size());
+                m_Records.resize(readCount);
+            }
+            m_RoutineCount = routineNames.size();
+            return true;
+        }
+
+        void CommandLogReader::GetCommand(std::size_t index, Command& command, RoutineRequests& routines) const {
+            const CommandRecord& record = m_Records[index];
+            command.driveForward = record.driveForward;
+            command.driveTurn = record.driveTurn;
+            command.flipper = record.flipper;
+            command.ballIntake = record.ballIntake;
+            command.elevatorInput = record.elevatorInput;
+            command.outrigger = record.outrigger;
+            command.outriggerWheel = record.outriggerWheel;
+            command.elevatorSetPoint = record.elevatorSetPoint;
+            command.flipperAngle = record.flipperAngle;
+            command.hatchIntakeDown = record.hatchIntakeDown != 0;
+            command.offTheBooksModeEnabled = record.offTheBooksModeEnabled != 0;
+            command.isQuickTurn = record.isQuickTurn != 0;
+            command.terminateRoutines = record.terminateRoutines != 0;
+            command.autoAlign = record.autoAlign != 0;
+            command.autoAlignPressed = record.autoAlignPressed != 0;
+            command.autoAlignReleased = record.autoAlignReleased != 0;
+            command.hasElevatorSetPoint = record.hasElevatorSetPoint != 0;
+            command.hasFlipperAngle = record.hasFlipperAngle != 0;
+            routines.clear();
+            for (uint8_t i = 0; i < std::min(record.routineCount, static_cast<uint8_t>(COMMAND_LOG_MAX_ROUTINES)); i++) {
+                if (record.routines[i] < m_RoutineCount) {
+                    routines.push_back(static_cast<CommandRoutine>(record.routines[i]));
+                }
+            }
+        }
+    }
+}
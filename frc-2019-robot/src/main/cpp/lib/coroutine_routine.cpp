@@ -0,0 +1,62 @@
+#include <lib/coroutine_routine.hpp>
+
+namespace garage {
+    namespace lib {
+        CoroutineRoutine::CoroutineRoutine(std::shared_ptr<Robot>& robot, const std::string& name) : Routine(robot, name) {
+
+        }
+
+        void CoroutineRoutine::Start() {
+            Routine::Start();
+            m_ResumePoint = 0;
+            m_ChildCount = 0;
+            // The first step happens right away like the start of any other routine
+            m_IsDone = Run();
+        }
+
+        void CoroutineRoutine::Update() {
+            if (!m_IsDone) {
+                m_IsDone = Run();
+            }
+        }
+
+        bool CoroutineRoutine::CheckFinished() {
+            return m_IsDone;
+        }
+
+        void CoroutineRoutine::Terminate() {
+            Routine::Terminate();
+            TerminateChildren();
+        }
+
+        void CoroutineRoutine::AddRequirements(const std::shared_ptr<Routine>& routine) {
+            m_Requirements |= routine->GetRequirements();
+        }
+
+        bool CoroutineRoutine::RunChildren() {
+            bool isFinished = true;
+            for (std::size_t i = 0; i < m_ChildCount; i++) {
+                if (!m_IsChildFinished[i]) {
+                    Routine* child = m_Children[i];
+                    // Terminated from outside counts as finished too
+                    m_IsChildFinished[i] = child->Periodic() || child->IsFinished();
+                    isFinished &= m_IsChildFinished[i];
+                }
+            }
+            if (isFinished)
+                m_ChildCount = 0;
+            else
+                SleepWithChildren(m_Children.begin(), m_Children.begin() + m_ChildCount);
+            return isFinished;
+        }
+
+        void CoroutineRoutine::TerminateChildren() {
+            for (std::size_t i = 0; i < m_ChildCount; i++) {
+                if (!m_IsChildFinished[i]) {
+                    m_Children[i]->Terminate();
+                }
+            }
+            m_ChildCount = 0;
+        }
+    }
+}
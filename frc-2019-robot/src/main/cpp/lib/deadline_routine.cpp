@@ -0,0 +1,16 @@
+#include <lib/deadline_routine.hpp>
+
+namespace garage {
+    namespace lib {
+        DeadlineRoutine::DeadlineRoutine(std::shared_ptr<Robot> robot, const std::string& name, const std::shared_ptr<Routine>& deadline,
+                                         RoutineVector&& routines) : RaceRoutine(robot, name, std::move(routines)) {
+            // Always first so it is started and updated before the others
+            m_SubRoutines.insert(m_SubRoutines.begin(), deadline);
+            m_Requirements |= deadline->GetRequirements();
+        }
+
+        bool DeadlineRoutine::CheckFinished() {
+            return m_SubRoutines.front()->IsFinished();
+        }
+    }
+}
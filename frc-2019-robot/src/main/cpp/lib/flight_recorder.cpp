@@ -0,0 +1,107 @@
+#include <lib/flight_recorder.hpp>
+
+#include <lib/logger.hpp>
+#include <lib/routine.hpp>
+#include <lib/subsystem.hpp>
+
+#include <cstring>
+#include <algorithm>
+
+namespace garage {
+    namespace lib {
+        FlightRecorder::~FlightRecorder() {
+            Close();
+        }
+
+        bool FlightRecorder::Open(const std::string& path, const std::vector<std::shared_ptr<Subsystem>>& subsystems,
+                                  std::shared_ptr<Clock> clock) {
+            Close();
+            if (!m_File.Open(path, sizeof(FlightRecorderHeader) + sizeof(FlightRecord) * FLIGHT_RECORDER_CAPACITY, "Flight Recorder")) return false;
+            m_Header = static_cast<FlightRecorderHeader*>(m_File.GetData());
+            m_Records = reinterpret_cast<FlightRecord*>(static_cast<char*>(m_File.GetData()) + sizeof(FlightRecorderHeader));
+            std::memset(m_Header, 0, sizeof(FlightRecorderHeader));
+            std::fill(std::begin(m_NameKeys), std::end(m_NameKeys), nullptr);
+            m_HasWarnedNamesFull = false;
+            m_Header->magic = FLIGHT_RECORDER_MAGIC;
+            m_Header->version = FLIGHT_RECORDER_VERSION;
+            m_Header->headerSize = sizeof(FlightRecorderHeader);
+            m_Header->recordSize = sizeof(FlightRecord);
+            m_Header->capacity = FLIGHT_RECORDER_CAPACITY;
+            Intern(this, "None");
+            const std::size_t subsystemCount = std::min(subsystems.size(), static_cast<std::size_t>(FLIGHT_RECORDER_MAX_SUBSYSTEMS));
+            if (subsystemCount < subsystems.size()) {
+                Logger::Log(Logger::LogLevel::k_Warning, "[Flight Recorder] Only recording the first {} subsystems", subsystemCount);
+            }
+            for (std::size_t i = 0; i < subsystemCount; i++) {
+                m_Header->subsystemNames[i] = Intern(subsystems[i].get(), subsystems[i]->GetName());
+            }
+            m_Header->subsystemCount = static_cast<uint32_t>(subsystemCount);
+            m_Clock = clock;
+            m_OpenTime = m_Clock->Now();
+            Logger::Log(Logger::LogLevel::k_Info, "[Flight Recorder] Recording to {}", path);
+            return true;
+        }
+
+        void FlightRecorder::Close() {
+            m_Header = nullptr;
+            m_Records = nullptr;
+            m_File.Close();
+        }
+
+        uint16_t FlightRecorder::Intern(const void* key, const std::string& name) {
+            if (!m_Header) return FLIGHT_RECORDER_NO_NAME;
+            const uint32_t nameCount = m_Header->nameCount;
+            for (uint32_t i = 0; i < nameCount; i++) {
+                if (m_NameKeys[i] == key) return static_cast<uint16_t>(i);
+            }
+            if (nameCount == FLIGHT_RECORDER_MAX_NAMES) {
+                if (!m_HasWarnedNamesFull) {
+                    Logger::Log(Logger::LogLevel::k_Warning, "[Flight Recorder] Name table is full, recording {} as none", name);
+                    m_HasWarnedNamesFull = true;
+                }
+                return FLIGHT_RECORDER_NO_NAME;
+            }
+            m_NameKeys[nameCount] = key;
+            char* destination = m_Header->names[nameCount];
+            const std::size_t length = std::min(name.size(), static_cast<std::size_t>(FLIGHT_RECORDER_NAME_SIZE - 1));
+            std::memcpy(destination, name.data(), length);
+            destination[length] = '\0';
+            m_Header->nameCount = nameCount + 1;
+            return static_cast<uint16_t>(nameCount);
+        }
+
+        void FlightRecorder::Record(const Command& command, const std::vector<std::shared_ptr<Routine>>& activeRoutines,
+                                    const std::vector<std::shared_ptr<Subsystem>>& subsystems) {
+            if (!m_Header) return;
+            const uint64_t recordCount = m_Header->recordCount;
+            FlightRecord& record = m_Records[recordCount % FLIGHT_RECORDER_CAPACITY];
+            std::memset(&record, 0, sizeof(FlightRecord));
+            record.sequence = static_cast<uint32_t>(recordCount);
+            record.timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                    m_Clock->Now() - m_OpenTime).count());
+            record.driveForward = static_cast<float>(command.driveForward);
+            record.driveTurn = static_cast<float>(command.driveTurn);
+            record.flipper = static_cast<float>(command.flipper);
+            record.ballIntake = static_cast<float>(command.ballIntake);
+            record.elevatorInput = static_cast<float>(command.elevatorInput);
+            record.outrigger = static_cast<float>(command.outrigger);
+            record.outriggerWheel = static_cast<float>(command.outriggerWheel);
+            record.hatchIntakeDown = command.hatchIntakeDown;
+            record.offTheBooksModeEnabled = command.offTheBooksModeEnabled;
+            record.isQuickTurn = command.isQuickTurn;
+            if (!activeRoutines.empty()) {
+                const auto& activeRoutine = activeRoutines.front();
+                record.activeRoutine = Intern(activeRoutine.get(), activeRoutine->GetName());
+            } else {
+                record.activeRoutine = FLIGHT_RECORDER_NO_NAME;
+            }
+            record.activeRoutineCount = static_cast<uint16_t>(std::min(activeRoutines.size(), static_cast<std::size_t>(UINT16_MAX)));
+            const uint32_t subsystemCount = std::min(m_Header->subsystemCount, static_cast<uint32_t>(subsystems.size()));
+            for (uint32_t i = 0; i < subsystemCount; i++) {
+                subsystems[i]->RecordTelemetry(*this, record.subsystems[i]);
+            }
+            // Count the record last so a crash mid write leaves at most a half written slot past the end
+            m_Header->recordCount = recordCount + 1;
+        }
+    }
+}
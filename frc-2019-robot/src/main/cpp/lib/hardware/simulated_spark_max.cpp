@@ -0,0 +1,133 @@
+#ifdef GARAGE_SIMULATION
+
+#include <lib/hardware/simulated_spark_max.hpp>
+
+#include <garage_math/garage_math.hpp>
+
+namespace garage {
+    namespace lib {
+        SimulatedSparkMax::Gains* SimulatedSparkMax::GetSlot(int slot) {
+            if (slot < 0 || slot >= SIMULATED_SPARK_MAX_SLOTS) {
+                Logger::Log(Logger::LogLevel::k_Error, "[Simulation] Spark Max {} has no slot {}", m_DeviceId, slot);
+                return nullptr;
+            }
+            return &m_Gains[slot];
+        }
+
+        bool SimulatedSparkMax::Follow(SimulatedSparkMax& leader, bool isInverted) {
+            m_Leader = &leader;
+            m_IsFollowerInverted = isInverted;
+            return true;
+        }
+
+        bool SimulatedSparkMax::RestoreFactoryDefaults() {
+            m_Leader = nullptr;
+            m_IsFollowerInverted = m_IsInverted = m_IsBrakeMode = m_IsClosedLoop = false;
+            m_OpenLoopRampRate = m_ClosedLoopRampRate = m_NominalVoltage = m_InputDeadband = 0.0;
+            m_Gains.fill(Gains{});
+            m_ForwardLimitSwitch.EnableLimitSwitch(false);
+            m_ReverseLimitSwitch.EnableLimitSwitch(false);
+            return true;
+        }
+
+        void SimulatedSparkMax::Set(double output) {
+            m_IsClosedLoop = false;
+            m_Output = math::clamp(output, -1.0, 1.0);
+            if (!m_IsModeled) m_AppliedOutput = m_IsInverted ? -m_Output : m_Output;
+        }
+
+        double SimulatedSparkMax::GetAppliedOutput() {
+            if (m_Leader && !m_IsModeled) {
+                return m_IsFollowerInverted ? -m_Leader->GetAppliedOutput() : m_Leader->GetAppliedOutput();
+            }
+            return m_AppliedOutput;
+        }
+
+        bool SimulatedSparkMax::SetReference(double reference, ControlType controlType, int slot, double arbitraryFeedForward) {
+            if (!GetSlot(slot)) return false;
+            m_IsClosedLoop = true;
+            m_Reference = reference;
+            m_ControlType = controlType;
+            m_Slot = slot;
+            m_ArbitraryFeedForward = arbitraryFeedForward;
+            return true;
+        }
+
+        bool SimulatedSparkMax::SetP(double p, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) gains->p = p;
+            return gains != nullptr;
+        }
+
+        bool SimulatedSparkMax::SetI(double i, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) gains->i = i;
+            return gains != nullptr;
+        }
+
+        bool SimulatedSparkMax::SetD(double d, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) gains->d = d;
+            return gains != nullptr;
+        }
+
+        bool SimulatedSparkMax::SetFF(double ff, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) gains->ff = ff;
+            return gains != nullptr;
+        }
+
+        bool SimulatedSparkMax::SetIZone(double iZone, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) gains->iZone = iZone;
+            return gains != nullptr;
+        }
+
+        bool SimulatedSparkMax::SetIMaxAccum(double maxAccumulator, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) gains->iMaxAccum = maxAccumulator;
+            return gains != nullptr;
+        }
+
+        bool SimulatedSparkMax::SetOutputRange(double minimum, double maximum, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) {
+                gains->minOutput = minimum;
+                gains->maxOutput = maximum;
+            }
+            return gains != nullptr;
+        }
+
+        bool SimulatedSparkMax::SetSmartMotionMaxVelocity(double maxVelocity, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) gains->maxVelocity = maxVelocity;
+            return gains != nullptr;
+        }
+
+        bool SimulatedSparkMax::SetSmartMotionMinOutputVelocity(double minVelocity, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) gains->minOutputVelocity = minVelocity;
+            return gains != nullptr;
+        }
+
+        bool SimulatedSparkMax::SetSmartMotionMaxAccel(double maxAcceleration, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) gains->maxAcceleration = maxAcceleration;
+            return gains != nullptr;
+        }
+
+        bool SimulatedSparkMax::SetSmartMotionAllowedClosedLoopError(double allowedError, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) gains->allowedError = allowedError;
+            return gains != nullptr;
+        }
+
+        bool SimulatedSparkMax::SetSmartMotionAccelStrategy(AccelStrategy accelStrategy, int slot) {
+            auto gains = GetSlot(slot);
+            if (gains) gains->accelStrategy = accelStrategy;
+            return gains != nullptr;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef GARAGE_SIMULATION
+
+#include <lib/hardware/spark_max.hpp>
+
+namespace garage {
+    namespace lib {
+        double RevSparkMaxEncoder::GetPosition() {
+            return m_Encoder.GetPosition();
+        }
+
+        double RevSparkMaxEncoder::GetVelocity() {
+            return m_Encoder.GetVelocity();
+        }
+
+        bool RevSparkMaxEncoder::SetPosition(double position) {
+            return m_Encoder.SetPosition(position) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMaxLimitSwitch::Get() {
+            return m_LimitSwitch.Get();
+        }
+
+        bool RevSparkMaxLimitSwitch::EnableLimitSwitch(bool isEnabled) {
+            return m_LimitSwitch.EnableLimitSwitch(isEnabled) == rev::CANError::kOK;
+        }
+
+        RevSparkMax::RevSparkMax(int deviceId) : m_Spark(deviceId, rev::CANSparkMax::MotorType::kBrushless) {}
+
+        bool RevSparkMax::Follow(RevSparkMax& leader, bool isInverted) {
+            return m_Spark.Follow(leader.m_Spark, isInverted) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::RestoreFactoryDefaults() {
+            return m_Spark.RestoreFactoryDefaults() == rev::CANError::kOK;
+        }
+
+        void RevSparkMax::Set(double output) {
+            m_Spark.Set(output);
+        }
+
+        double RevSparkMax::GetAppliedOutput() {
+            return m_Spark.GetAppliedOutput();
+        }
+
+        double RevSparkMax::GetOutputCurrent() {
+            return m_Spark.GetOutputCurrent();
+        }
+
+        void RevSparkMax::SetInverted(bool isInverted) {
+            m_Spark.SetInverted(isInverted);
+        }
+
+        bool RevSparkMax::SetBrakeMode(bool isBrakeMode) {
+            auto idleMode = isBrakeMode ? rev::CANSparkMax::IdleMode::kBrake : rev::CANSparkMax::IdleMode::kCoast;
+            return m_Spark.SetIdleMode(idleMode) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetOpenLoopRampRate(double rampSeconds) {
+            return m_Spark.SetOpenLoopRampRate(rampSeconds) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::EnableVoltageCompensation(double nominalVoltage) {
+            return m_Spark.EnableVoltageCompensation(nominalVoltage) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetReference(double reference, ControlType controlType, int slot, double arbitraryFeedForward) {
+            auto revControlType = controlType == ControlType::k_SmartMotion ? rev::ControlType::kSmartMotion : rev::ControlType::kSmartVelocity;
+            return m_Controller.SetReference(reference, revControlType, slot, arbitraryFeedForward) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetClosedLoopRampRate(double rampSeconds) {
+            return m_Spark.SetClosedLoopRampRate(rampSeconds) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetInputDeadband(double deadband) {
+            return m_Spark.SetParameter(rev::CANSparkMax::ConfigParameter::kInputDeadband, deadband) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetP(double p, int slot) {
+            return m_Controller.SetP(p, slot) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetI(double i, int slot) {
+            return m_Controller.SetI(i, slot) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetD(double d, int slot) {
+            return m_Controller.SetD(d, slot) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetFF(double ff, int slot) {
+            return m_Controller.SetFF(ff, slot) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetIZone(double iZone, int slot) {
+            return m_Controller.SetIZone(iZone, slot) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetIMaxAccum(double maxAccumulator, int slot) {
+            return m_Controller.SetIMaxAccum(maxAccumulator, slot) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetOutputRange(double minimum, double maximum, int slot) {
+            return m_Controller.SetOutputRange(minimum, maximum, slot) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetSmartMotionMaxVelocity(double maxVelocity, int slot) {
+            return m_Controller.SetSmartMotionMaxVelocity(maxVelocity, slot) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetSmartMotionMinOutputVelocity(double minVelocity, int slot) {
+            return m_Controller.SetSmartMotionMinOutputVelocity(minVelocity, slot) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetSmartMotionMaxAccel(double maxAcceleration, int slot) {
+            return m_Controller.SetSmartMotionMaxAccel(maxAcceleration, slot) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetSmartMotionAllowedClosedLoopError(double allowedError, int slot) {
+            return m_Controller.SetSmartMotionAllowedClosedLoopError(allowedError, slot) == rev::CANError::kOK;
+        }
+
+        bool RevSparkMax::SetSmartMotionAccelStrategy(AccelStrategy accelStrategy, int slot) {
+            auto revAccelStrategy = accelStrategy == AccelStrategy::k_SCurve
+                                    ? rev::CANPIDController::AccelStrategy::kSCurve : rev::CANPIDController::AccelStrategy::kTrapezoidal;
+            return m_Controller.SetSmartMotionAccelStrategy(revAccelStrategy, slot) == rev::CANError::kOK;
+        }
+
+        uint16_t RevSparkMax::GetStickyFaults() {
+            return m_Spark.GetStickyFaults();
+        }
+
+        bool RevSparkMax::ClearFaults() {
+            return m_Spark.ClearFaults() == rev::CANError::kOK;
+        }
+    }
+}
+
+#endif
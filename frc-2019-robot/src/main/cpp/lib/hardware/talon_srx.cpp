@@ -0,0 +1,49 @@
+#ifndef GARAGE_SIMULATION
+
+#include <lib/hardware/talon_srx.hpp>
+
+#include <hardware_map.hpp>
+
+namespace garage {
+    namespace lib {
+        CtreTalonSRX::CtreTalonSRX(int deviceId) : m_Talon(deviceId) {}
+
+        bool CtreTalonSRX::RestoreFactoryDefaults() {
+            return m_Talon.ConfigFactoryDefault(CONFIG_TIMEOUT) == ctre::phoenix::OK;
+        }
+
+        void CtreTalonSRX::Set(double output) {
+            m_Talon.Set(ctre::phoenix::motorcontrol::ControlMode::PercentOutput, output);
+        }
+
+        double CtreTalonSRX::GetAppliedOutput() {
+            return m_Talon.GetMotorOutputPercent();
+        }
+
+        double CtreTalonSRX::GetOutputCurrent() {
+            return m_Talon.GetOutputCurrent();
+        }
+
+        void CtreTalonSRX::SetInverted(bool isInverted) {
+            m_Talon.SetInverted(isInverted);
+        }
+
+        bool CtreTalonSRX::SetBrakeMode(bool isBrakeMode) {
+            m_Talon.SetNeutralMode(isBrakeMode ? ctre::phoenix::motorcontrol::NeutralMode::Brake : ctre::phoenix::motorcontrol::NeutralMode::Coast);
+            return true;
+        }
+
+        bool CtreTalonSRX::SetOpenLoopRampRate(double rampSeconds) {
+            // No timeout so it can be changed while running without blocking the loop
+            return m_Talon.ConfigOpenloopRamp(rampSeconds) == ctre::phoenix::OK;
+        }
+
+        bool CtreTalonSRX::EnableVoltageCompensation(double nominalVoltage) {
+            auto error = m_Talon.ConfigVoltageCompSaturation(nominalVoltage, CONFIG_TIMEOUT);
+            m_Talon.EnableVoltageCompensation(true);
+            return error == ctre::phoenix::OK;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,77 @@
+#include <lib/log_buffer.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+
+#define LOG_BUFFER_FLOATING_DIGITS 6 // Matches the precision of %f
+
+namespace garage {
+    namespace lib {
+        void LogBuffer::Append(const char* text, std::size_t length) {
+            const std::size_t copyLength = std::min(length, LOG_BUFFER_SIZE - m_Length);
+            std::memcpy(m_Data + m_Length, text, copyLength);
+            m_Length += copyLength;
+        }
+
+        void LogBuffer::AppendSigned(long long value) {
+            if (value < 0) {
+                Append('-');
+                // Negate in unsigned space so the minimum value does not overflow
+                AppendUnsigned(0ull - static_cast<unsigned long long>(value));
+            } else {
+                AppendUnsigned(static_cast<unsigned long long>(value));
+            }
+        }
+
+        void LogBuffer::AppendUnsigned(unsigned long long value) {
+            char digits[20];
+            int count = 0;
+            do {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value);
+            std::reverse(digits, digits + count);
+            Append(digits, static_cast<std::size_t>(count));
+        }
+
+        void LogBuffer::AppendFloating(double value) {
+            if (std::isnan(value)) {
+                Append("nan");
+                return;
+            }
+            if (value < 0.0) {
+                Append('-');
+                value = -value;
+            }
+            if (std::isinf(value)) {
+                Append("inf");
+                return;
+            }
+            if (value >= 1e18) {
+                // Too large for the integral part to fit, printing scientific notation into a stack buffer does not allocate
+                char scientific[32];
+                const int length = std::snprintf(scientific, sizeof(scientific), "%e", value);
+                Append(scientific, static_cast<std::size_t>(std::max(length, 0)));
+                return;
+            }
+            unsigned long long scale = 1;
+            for (int i = 0; i < LOG_BUFFER_FLOATING_DIGITS; i++) scale *= 10;
+            auto integral = static_cast<unsigned long long>(value);
+            auto fractional = static_cast<unsigned long long>(std::llround((value - integral) * scale));
+            // Rounding can carry all the way into the integral part
+            if (fractional >= scale) {
+                integral++;
+                fractional -= scale;
+            }
+            AppendUnsigned(integral);
+            Append('.');
+            char digits[LOG_BUFFER_FLOATING_DIGITS];
+            for (int i = LOG_BUFFER_FLOATING_DIGITS - 1; i >= 0; i--) {
+                digits[i] = static_cast<char>('0' + fractional % 10);
+                fractional /= 10;
+            }
+            Append(digits, LOG_BUFFER_FLOATING_DIGITS);
+        }
+    }
+}
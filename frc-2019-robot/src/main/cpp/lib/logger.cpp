@@ -1,35 +1,130 @@
 #include <lib/logger.hpp>
 
+#include <lib/mpsc_ring_buffer.hpp>
+
 #include <wpi/raw_ostream.h>
 
+#include <chrono>
 #include <cstdarg>
+#include <cstring>
+#include <algorithm>
 
 namespace garage {
     namespace lib {
-        Logger::LogLevel Logger::s_LogLevel = LogLevel::k_Info;
+        struct LogRecord {
+            std::size_t length;
+            char text[LOG_RECORD_SIZE];
+        };
+
+        static MpscRingBuffer<LogRecord, LOG_QUEUE_CAPACITY> s_Queue;
+        static std::atomic<bool> s_IsBackendRunning{false};
+
+        constexpr Logger::LogLevel Logger::k_CompiledLogLevel;
+        std::atomic<Logger::LogLevel> Logger::s_LogLevel{LogLevel::k_Info};
+        std::atomic<bool> Logger::s_IsAsync{false};
+        std::atomic<unsigned long> Logger::s_DroppedRecords{0};
+        std::thread Logger::s_Thread;
 
         std::string Logger::Format(const std::string& format, ...) {
-            // TODO fixed size buffer for better performance?
+            // Most lines fit on the stack, only fall back to sizing a string for long ones
+            char buffer[LOG_BUFFER_SIZE];
             va_list arguments;
                     va_start(arguments, format);
-            auto length = static_cast<size_t>(std::vsnprintf(nullptr, 0, FMT_STR(format), arguments));
+            const int length = std::vsnprintf(buffer, sizeof(buffer), FMT_STR(format), arguments);
                     va_end(arguments);
-            std::vector<char> output(length + 1);
+            if (length < 0) {
+                return {};
+            }
+            if (static_cast<size_t>(length) < sizeof(buffer)) {
+                return std::string(buffer, static_cast<size_t>(length));
+            }
+            std::string output(static_cast<size_t>(length), '\0');
                     va_start(arguments, format);
-            auto* front = output.data();
-            std::vsnprintf(front, length + 1, FMT_STR(format), arguments);
+            std::vsnprintf(&output[0], output.size() + 1, FMT_STR(format), arguments);
                     va_end(arguments);
-            return front;
+            return output;
         }
 
         void Logger::SetLogLevel(LogLevel logLevel) {
             s_LogLevel = logLevel;
+            if (logLevel > k_CompiledLogLevel) {
+                Log(LogLevel::k_Warning, "Log level {} is not compiled in, only up to {} will be logged", logLevel, k_CompiledLogLevel);
+            }
+        }
+
+        void Logger::Log(LogLevel logLevel, const std::string& log) {
+            Write(logLevel, log.data(), log.size());
+        }
+
+        void Logger::Log(LogLevel logLevel, const LogBuffer& log) {
+            Write(logLevel, log.GetData(), log.GetLength());
+        }
+
+        LogBuffer& Logger::GetThreadBuffer() {
+            static thread_local LogBuffer s_Buffer;
+            return s_Buffer;
+        }
+
+        void Logger::Write(LogLevel logLevel, const char* log, std::size_t length) {
+            if (IsEnabled(logLevel)) {
+                if (IsAsync()) {
+                    const bool pushed = s_Queue.TryPush([log, length](LogRecord& record) {
+                        record.length = std::min(length, sizeof(record.text));
+                        std::memcpy(record.text, log, record.length);
+                    });
+                    if (!pushed) {
+                        s_DroppedRecords.fetch_add(1, std::memory_order_relaxed);
+                    }
+                } else {
+                    WriteSynchronous(log, length);
+                }
+            }
+        }
+
+        void Logger::WriteSynchronous(const char* log, std::size_t length) {
+            wpi::outs() << wpi::StringRef(log, length) << '\n';
+        }
+
+        void Logger::StartAsync() {
+            if (!s_IsBackendRunning.exchange(true)) {
+                s_Thread = std::thread(&Logger::RunBackend);
+                s_IsAsync = true;
+            }
+        }
+
+        void Logger::StopAsync() {
+            s_IsAsync = false;
+            if (s_IsBackendRunning.exchange(false)) {
+                s_Thread.join();
+            }
         }
 
-        void Logger::Log(LogLevel logLevel, std::string log) {
-            if (logLevel <= s_LogLevel) {
-                wpi::outs() << log << '\n';
+        void Logger::RunBackend() {
+            auto& output = wpi::outs();
+            unsigned long reportedDropped = 0;
+            auto writeRecord = [&output](LogRecord& record) {
+                output << wpi::StringRef(record.text, record.length) << '\n';
+            };
+            while (s_IsBackendRunning.load(std::memory_order_relaxed)) {
+                bool wroteAny = false;
+                while (s_Queue.TryPop(writeRecord)) {
+                    wroteAny = true;
+                }
+                const unsigned long dropped = GetDroppedCount();
+                if (dropped != reportedDropped) {
+                    output << "[Logger] Dropped " << dropped - reportedDropped << " log records, queue was full\n";
+                    reportedDropped = dropped;
+                    wroteAny = true;
+                }
+                if (wroteAny) {
+                    output.flush();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(LOG_FLUSH_INTERVAL));
+                }
             }
+            // Producers may still be finishing a push after the mode was switched, drain what made it in
+            while (s_Queue.TryPop(writeRecord));
+            output.flush();
         }
     }
-}
\ No newline at end of file
+}
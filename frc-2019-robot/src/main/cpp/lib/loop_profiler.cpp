@@ -0,0 +1,96 @@
+#include <lib/loop_profiler.hpp>
+
+#include <lib/logger.hpp>
+
+#include <cmath>
+#include <algorithm>
+
+namespace garage {
+    namespace lib {
+        int PhaseHistogram::GetBucket(uint32_t nanoseconds) {
+            if (nanoseconds < (1u << PROFILER_MIN_SHIFT)) return 0;
+            // Power of two picks the group, the next two bits pick the bucket inside of it
+            const int exponent = 31 - __builtin_clz(nanoseconds);
+            const int subBucket = static_cast<int>((nanoseconds >> (exponent - 2)) & (PROFILER_SUB_BUCKETS - 1));
+            const int bucket = 1 + (exponent - PROFILER_MIN_SHIFT) * PROFILER_SUB_BUCKETS + subBucket;
+            return std::min(bucket, PROFILER_BUCKET_COUNT - 1);
+        }
+
+        uint32_t PhaseHistogram::GetBucketUpperBound(int bucket) {
+            if (bucket == 0) return 1u << PROFILER_MIN_SHIFT;
+            const int exponent = (bucket - 1) / PROFILER_SUB_BUCKETS + PROFILER_MIN_SHIFT, subBucket = (bucket - 1) % PROFILER_SUB_BUCKETS;
+            const uint64_t upperBound = (static_cast<uint64_t>(PROFILER_SUB_BUCKETS + subBucket + 1) << exponent) / PROFILER_SUB_BUCKETS;
+            return static_cast<uint32_t>(std::min<uint64_t>(upperBound, UINT32_MAX));
+        }
+
+        void PhaseHistogram::Record(uint32_t nanoseconds) {
+            m_Buckets[GetBucket(nanoseconds)]++;
+            m_Count++;
+            if (nanoseconds > m_Max) m_Max = nanoseconds;
+        }
+
+        void PhaseHistogram::Clear() {
+            m_Buckets.fill(0);
+            m_Count = 0;
+            m_Max = 0;
+        }
+
+        uint32_t PhaseHistogram::GetPercentile(double fraction) const {
+            if (m_Count == 0) return 0;
+            const auto target = static_cast<uint32_t>(std::ceil(fraction * m_Count));
+            uint32_t cumulative = 0;
+            for (int bucket = 0; bucket < PROFILER_BUCKET_COUNT; bucket++) {
+                cumulative += m_Buckets[bucket];
+                if (cumulative >= target) {
+                    // The exact max is known, so never report a bucket bound past it
+                    return std::min(GetBucketUpperBound(bucket), m_Max);
+                }
+            }
+            return m_Max;
+        }
+
+        void LoopProfiler::Initialize(std::shared_ptr<nt::NetworkTable> networkTable) {
+            m_NetworkTable = networkTable;
+            m_Phases.reserve(PROFILER_MAX_PHASES);
+        }
+
+        int LoopProfiler::AddPhase(const std::string& name) {
+            if (m_Phases.size() == PROFILER_MAX_PHASES) {
+                Logger::Log(Logger::LogLevel::k_Warning, "[Profiler] No slots left for phase {}, it will not be recorded", name);
+                return -1;
+            }
+            Phase phase;
+            phase.name = name;
+            if (m_NetworkTable) {
+                // Keeping the entries means publishing does not have to look up names
+                auto phaseTable = m_NetworkTable->GetSubTable(name);
+                phase.p50Entry = phaseTable->GetEntry("p50");
+                phase.p99Entry = phaseTable->GetEntry("p99");
+                phase.maxEntry = phaseTable->GetEntry("Max");
+            }
+            m_Phases.push_back(std::move(phase));
+            return static_cast<int>(m_Phases.size() - 1);
+        }
+
+        void LoopProfiler::EndLoop() {
+            if (m_IsEnabled && ++m_LoopCount % PROFILER_PUBLISH_INTERVAL == 0) {
+                Publish();
+            }
+        }
+
+        void LoopProfiler::Publish() {
+            for (auto& phase : m_Phases) {
+                auto& histogram = phase.histogram;
+                if (m_NetworkTable) {
+                    phase.p50Entry.SetDouble(histogram.GetPercentile(0.5) / 1000.0);
+                    phase.p99Entry.SetDouble(histogram.GetPercentile(0.99) / 1000.0);
+                    phase.maxEntry.SetDouble(histogram.GetMax() / 1000.0);
+                }
+                Logger::Log(Logger::LogLevel::k_Verbose, "[Profiler] {}: p50 {} us, p99 {} us, max {} us, {} samples", phase.name,
+                            histogram.GetPercentile(0.5) / 1000, histogram.GetPercentile(0.99) / 1000, histogram.GetMax() / 1000,
+                            histogram.GetCount());
+                histogram.Clear();
+            }
+        }
+    }
+}
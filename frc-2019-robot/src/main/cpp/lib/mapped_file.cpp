@@ -0,0 +1,58 @@
+#include <lib/mapped_file.hpp>
+
+#include <lib/logger.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace garage {
+    namespace lib {
+        bool MappedFile::Open(const std::string& path, std::size_t size, const char* ownerName) {
+            Close();
+            m_FileDescriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (m_FileDescriptor < 0) {
+                Logger::Log(Logger::LogLevel::k_Error, "[{}] Could not open {}: {}", ownerName, path, std::strerror(errno));
+                return false;
+            }
+            // Reserve the blocks up front so writing through the mapping never has to grow the file
+            const int allocateError = posix_fallocate(m_FileDescriptor, 0, static_cast<off_t>(size));
+            if (allocateError) {
+                Logger::Log(Logger::LogLevel::k_Error, "[{}] Could not allocate {} bytes: {}", ownerName, size, std::strerror(allocateError));
+                Close();
+                return false;
+            }
+            void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_FileDescriptor, 0);
+            if (mapping == MAP_FAILED) {
+                Logger::Log(Logger::LogLevel::k_Error, "[{}] Could not map file: {}", ownerName, std::strerror(errno));
+                Close();
+                return false;
+            }
+            m_Mapping = mapping;
+            m_Size = size;
+            return true;
+        }
+
+        void MappedFile::Close() {
+            if (m_Mapping) {
+                msync(m_Mapping, m_Size, MS_SYNC);
+                munmap(m_Mapping, m_Size);
+                m_Mapping = nullptr;
+            }
+            m_Size = 0;
+            if (m_FileDescriptor >= 0) {
+                close(m_FileDescriptor);
+                m_FileDescriptor = -1;
+            }
+        }
+
+        void MappedFile::Flush() {
+            if (m_Mapping) {
+                msync(m_Mapping, m_Size, MS_ASYNC);
+            }
+        }
+    }
+}
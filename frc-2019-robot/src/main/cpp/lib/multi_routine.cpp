@@ -7,11 +7,19 @@ namespace garage {
         MultiRoutine::MultiRoutine(std::shared_ptr<Robot> robot, const std::string& name, RoutineVector&& routines)
                 : Routine(robot, name) {
             m_SubRoutines = routines;
+            AddSubRoutineRequirements();
         }
 
         MultiRoutine::MultiRoutine(std::shared_ptr<Robot> robot, const std::string& name, RoutineVector& routines)
                 : Routine(robot, name) {
             m_SubRoutines = routines;
+            AddSubRoutineRequirements();
+        }
+
+        void MultiRoutine::AddSubRoutineRequirements() {
+            for (auto& routine : m_SubRoutines) {
+                m_Requirements |= routine->GetRequirements();
+            }
         }
     }
 }
\ No newline at end of file
@@ -16,6 +16,7 @@ namespace garage {
             for (auto& routine : m_SubRoutines) {
                 routine->Periodic();
             }
+            SleepWithChildren(m_SubRoutines.begin(), m_SubRoutines.end());
         }
 
         bool ParallelRoutine::CheckFinished() {
@@ -26,6 +27,7 @@ namespace garage {
         }
 
         void ParallelRoutine::Terminate() {
+            Routine::Terminate();
             for (auto& routine : m_SubRoutines)
                 routine->Terminate();
         }
@@ -0,0 +1,21 @@
+#include <lib/race_routine.hpp>
+
+#include <algorithm>
+
+namespace garage {
+    namespace lib {
+        bool RaceRoutine::CheckFinished() {
+            return m_SubRoutines.empty() || std::any_of(m_SubRoutines.begin(), m_SubRoutines.end(),
+                                                        [](auto& routine) {
+                                                            return routine->IsFinished();
+                                                        });
+        }
+
+        void RaceRoutine::Terminate() {
+            Routine::Terminate();
+            for (auto& routine : m_SubRoutines) {
+                if (!routine->IsFinished()) routine->Terminate();
+            }
+        }
+    }
+}
@@ -3,34 +3,71 @@
 #include <robot.hpp>
 
 #include <lib/logger.hpp>
+#include <lib/subsystem.hpp>
+#include <lib/routine_tracer.hpp>
+
+#include <chrono>
 
 namespace garage {
     namespace lib {
-        Routine::Routine(std::shared_ptr<Robot>& robot, const std::string& name) : m_Robot(robot), m_Name(name) {
+        Routine::Routine(std::shared_ptr<Robot>& robot, const std::string& name) : m_Robot(robot), m_Clock(robot->GetClock()), m_Name(name) {
 
         }
 
         void Routine::Start() {
-            Logger::Log(Logger::LogLevel::k_Info, Logger::Format("[%s] Starting routine", FMT_STR(m_Name)));
+            Logger::Log(Logger::LogLevel::k_Info, "[{}] Starting routine", m_Name);
             m_IsFinished = false;
+            m_IsSleeping = false;
+            if (RoutineTracer::IsEnabled()) {
+                m_TraceRunId = RoutineTracer::NextRunId();
+                RoutineTracer::Record(RoutineTracer::EventType::k_Start, m_Name, m_TraceRunId, m_Clock->Now());
+            }
         }
 
         void Routine::Terminate() {
-            Logger::Log(Logger::LogLevel::k_Info, Logger::Format("[%s] Terminating routine", FMT_STR(m_Name)));
+            Logger::Log(Logger::LogLevel::k_Info, "[{}] Terminating routine", m_Name);
             m_IsFinished = true;
+            m_IsSleeping = false;
+            // Finishing already ended the run
+            if (m_TraceRunId) {
+                RoutineTracer::Record(RoutineTracer::EventType::k_Terminate, m_Name, m_TraceRunId, m_Clock->Now());
+                m_TraceRunId = 0;
+            }
         }
 
         bool Routine::Periodic() {
             if (m_IsFinished) {
                 return false;
             } else {
+                // Has to sleep again every update it wants to skip
+                m_IsSleeping = false;
+                const bool isTracing = RoutineTracer::IsEnabled();
+                // Placed by the robot clock but timed by the steady one, a simulated clock does not move during an update
+                const Clock::TimePoint updateTime = isTracing ? m_Clock->Now() : Clock::TimePoint();
+                const auto updateStart = isTracing ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
                 Update();
                 const bool isFinished = CheckFinished();
+                if (isTracing) {
+                    const auto duration = std::chrono::duration_cast<Clock::Duration>(std::chrono::steady_clock::now() - updateStart);
+                    RoutineTracer::Record(RoutineTracer::EventType::k_Update, m_Name, m_TraceRunId, updateTime, duration);
+                    if (isFinished && m_TraceRunId) {
+                        RoutineTracer::Record(RoutineTracer::EventType::k_Finish, m_Name, m_TraceRunId, updateTime + duration);
+                        m_TraceRunId = 0;
+                    }
+                }
                 if (isFinished) {
                     Terminate();
                 }
                 return isFinished;
             }
         }
+
+        void Routine::AddRequirement(const std::shared_ptr<Subsystem>& subsystem) {
+            m_Requirements |= subsystem ? subsystem->GetRequirement() : k_MissingSubsystemRequirement;
+        }
+
+        bool Routine::ShouldTerminateBasedOnUnlock(const Subsystem& subsystem) {
+            return (m_Requirements & subsystem.GetRequirement()) != 0;
+        }
     }
 }
@@ -2,69 +2,231 @@
 
 #include <robot.hpp>
 
+#include <lib/routine_tracer.hpp>
+
+#include <chrono>
+#include <algorithm>
+
 namespace garage {
     namespace lib {
-        RoutineManager::RoutineManager(std::shared_ptr<Robot>& robot) : m_Robot(robot) {
-
-        }
+        static const std::string s_TraceName = "Routine Manager";
 
-        void RoutineManager::AddRoutinesFromCommand(Command& command) {
-            for (auto& routine : command.routines) {
-                AddRoutine(routine);
-            }
+        RoutineManager::RoutineManager(std::shared_ptr<Robot>& robot) : m_Robot(robot), m_Clock(robot->GetClock()) {
+            // Everything in the queue could be running at once
+            m_ActiveRoutines.reserve(ROUTINE_QUEUE_CAPACITY);
+            m_ActiveRoutineStartTimes.reserve(ROUTINE_QUEUE_CAPACITY);
+            m_AwakeRoutines.reserve(ROUTINE_QUEUE_CAPACITY);
+            m_EventRoutines.reserve(ROUTINE_QUEUE_CAPACITY);
+            m_TimerWheel.Reset(m_Clock->Now());
         }
 
-        void RoutineManager::AddRoutine(std::shared_ptr<Routine> routine) {
-            // Make sure we are not adding the same exact routine twice
+        void RoutineManager::AddRoutine(const std::shared_ptr<Routine>& routine) {
             if (!routine) {
                 Logger::Log(Logger::LogLevel::k_Error, "Trying to add a null routine");
                 return;
             }
-            // TODO std function? who writes their own algorithms anyways
-            for (auto& existingRoutine : m_QueuedRoutines) {
-                if (routine == existingRoutine) {
-                    return;
-                }
+            if (routine->IsMissingSubsystem()) {
+                Logger::Log(Logger::LogLevel::k_Warning, "[{}] Requires a disabled subsystem, not adding", routine->GetName());
+                return;
+            }
+            // Adding the same exact routine twice is ignored
+            if (routine->IsQueued()) return;
+            if (m_QueuedRoutines.Push(routine)) {
+                m_ShouldStartQueued = true;
+            } else {
+                Logger::Log(Logger::LogLevel::k_Error, "[{}] Routine queue is full, not adding", routine->GetName());
             }
-            m_QueuedRoutines.push_back(routine);
         }
 
         void RoutineManager::Update() {
-            if (m_ActiveRoutine) {
-                if (m_ActiveRoutine->Periodic()) {
-                    m_ActiveRoutine.reset();
+            const Clock::TimePoint updateTime = m_Clock->Now();
+            // Timed by the steady clock since a simulated one does not move during the update
+            const bool isTracing = RoutineTracer::IsEnabled();
+            const auto updateStart = isTracing ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+            WakeDueRoutines(updateTime);
+            // Parked and finished routines are dropped in place, the rest keep their order
+            std::size_t awakeCount = 0;
+            for (std::size_t i = 0; i < m_AwakeRoutines.size(); i++) {
+                Routine* routine = m_AwakeRoutines[i];
+                if (routine->Periodic()) {
+                    const std::size_t index = GetActiveIndex(*routine);
+                    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(m_Clock->Now() - m_ActiveRoutineStartTimes[index]);
+                    Logger::Log(Logger::LogLevel::k_Debug, "[{}] Finished routine in {} milliseconds", routine->GetName(), duration);
+                    RemoveActiveRoutine(index);
+                } else if (routine->IsFinished()) {
+                    // Terminated from outside, such as by a subsystem being unlocked
+                    RemoveActiveRoutine(GetActiveIndex(*routine));
+                } else if (!routine->IsSleeping() || !Park(*routine)) {
+                    m_AwakeRoutines[awakeCount++] = routine;
                 }
             }
-            if (!m_QueuedRoutines.empty() && !m_ActiveRoutine) {
-                m_ActiveRoutine = m_QueuedRoutines.front();
-                m_ActiveRoutine->Start();
-                m_QueuedRoutines.pop_front();
+            m_AwakeRoutines.resize(awakeCount);
+            if (m_ShouldStartQueued) {
+                StartQueuedRoutines();
+            }
+            if (isTracing) {
+                RoutineTracer::Record(RoutineTracer::EventType::k_Update, s_TraceName, 0, updateTime,
+                                      std::chrono::duration_cast<Clock::Duration>(std::chrono::steady_clock::now() - updateStart));
             }
         }
 
-        void RoutineManager::TerminateAllRoutines() {
-            TerminateActiveRoutine();
-            while (!m_QueuedRoutines.empty()) {
-                auto routine = m_QueuedRoutines.front();
-                routine->Terminate();
-                m_QueuedRoutines.pop_front();
+        void RoutineManager::StartQueuedRoutines() {
+            RequirementMask waitingRequirements = 0;
+            m_QueuedRoutines.RemoveIf([&](std::shared_ptr<Routine>& routine) {
+                const RequirementMask requirements = routine->GetRequirements();
+                if ((requirements & waitingRequirements) || IsActive(routine) || !CanInterrupt(*routine)) {
+                    waitingRequirements |= requirements;
+                    return false;
+                }
+                if (requirements & m_ActiveRequirements) {
+                    for (std::size_t i = 0; i < m_ActiveRoutines.size();) {
+                        auto& activeRoutine = m_ActiveRoutines[i];
+                        if (activeRoutine->GetRequirements() & requirements) {
+                            Logger::Log(Logger::LogLevel::k_Info, "[{}] Interrupted by {}", activeRoutine->GetName(), routine->GetName());
+                            activeRoutine->Interrupt();
+                            auto awakeRoutine = std::find(m_AwakeRoutines.begin(), m_AwakeRoutines.end(), activeRoutine.get());
+                            if (awakeRoutine != m_AwakeRoutines.end())
+                                m_AwakeRoutines.erase(awakeRoutine);
+                            else
+                                Unpark(*activeRoutine);
+                            RemoveActiveRoutine(i);
+                        } else {
+                            i++;
+                        }
+                    }
+                }
+                m_ActiveRoutines.push_back(routine);
+                m_ActiveRoutineStartTimes.push_back(m_Clock->Now());
+                m_AwakeRoutines.push_back(routine.get());
+                m_ActiveRequirements |= requirements;
+                routine->Start();
+                return true;
+            });
+            m_ShouldStartQueued = false;
+        }
+
+        void RoutineManager::RemoveActiveRoutine(std::size_t index) {
+            // Keeps the order so the oldest routine stays first
+            m_ActiveRoutines.erase(m_ActiveRoutines.begin() + index);
+            m_ActiveRoutineStartTimes.erase(m_ActiveRoutineStartTimes.begin() + index);
+            UpdateActiveRequirements();
+            m_ShouldStartQueued = true;
+        }
+
+        std::size_t RoutineManager::GetActiveIndex(const Routine& routine) const {
+            auto activeRoutine = std::find_if(m_ActiveRoutines.begin(), m_ActiveRoutines.end(),
+                                              [&routine](const std::shared_ptr<Routine>& other) { return other.get() == &routine; });
+            return static_cast<std::size_t>(activeRoutine - m_ActiveRoutines.begin());
+        }
+
+        bool RoutineManager::Park(Routine& routine) {
+            const Clock::TimePoint wakeTime = routine.GetWakeTime();
+            const RequirementMask wakeEvents = routine.GetWakeEvents();
+            if (wakeTime != Clock::TimePoint::max()) {
+                if (!m_TimerWheel.Schedule(routine, wakeTime)) return false;
+            } else if (!wakeEvents) {
+                return false;
             }
+            if (wakeEvents) m_EventRoutines.push_back(&routine);
+            return true;
         }
 
-        void RoutineManager::Reset() {
-            m_ActiveRoutine.reset();
-            m_QueuedRoutines.clear();
+        void RoutineManager::Unpark(Routine& routine) {
+            m_TimerWheel.Cancel(routine);
+            if (routine.GetWakeEvents()) {
+                auto eventRoutine = std::find(m_EventRoutines.begin(), m_EventRoutines.end(), &routine);
+                if (eventRoutine != m_EventRoutines.end()) m_EventRoutines.erase(eventRoutine);
+            }
+        }
+
+        void RoutineManager::WakeRoutine(Routine& routine) {
+            Unpark(routine);
+            m_AwakeRoutines.push_back(&routine);
         }
 
-        void RoutineManager::TerminateActiveRoutine() {
-            if (m_ActiveRoutine) {
-                m_ActiveRoutine->Terminate();
-                m_ActiveRoutine.reset();
+        void RoutineManager::WakeDueRoutines(Clock::TimePoint now) {
+            m_TimerWheel.Advance(now, [this](Routine& routine) {
+                WakeRoutine(routine);
+            });
+            const RequirementMask pendingEvents = m_PendingEvents.exchange(0, std::memory_order_relaxed);
+            if (pendingEvents) {
+                std::size_t waitingCount = 0;
+                for (Routine* routine : m_EventRoutines) {
+                    if (routine->GetWakeEvents() & pendingEvents) {
+                        m_TimerWheel.Cancel(*routine);
+                        m_AwakeRoutines.push_back(routine);
+                    } else {
+                        m_EventRoutines[waitingCount++] = routine;
+                    }
+                }
+                m_EventRoutines.resize(waitingCount);
+            }
+        }
+
+        void RoutineManager::UpdateActiveRequirements() {
+            m_ActiveRequirements = 0;
+            for (auto& routine : m_ActiveRoutines) {
+                m_ActiveRequirements |= routine->GetRequirements();
+            }
+        }
+
+        bool RoutineManager::CanInterrupt(const Routine& routine) const {
+            const RequirementMask requirements = routine.GetRequirements();
+            if (!(requirements & m_ActiveRequirements)) return true;
+            for (auto& activeRoutine : m_ActiveRoutines) {
+                if ((activeRoutine->GetRequirements() & requirements) && activeRoutine->GetPriority() >= routine.GetPriority()) {
+                    return false;
+                }
             }
+            return true;
+        }
+
+        bool RoutineManager::IsActive(const std::shared_ptr<Routine>& routine) const {
+            return std::find(m_ActiveRoutines.begin(), m_ActiveRoutines.end(), routine) != m_ActiveRoutines.end();
         }
 
-        std::weak_ptr<Routine> RoutineManager::GetActiveRoutine() {
-            return m_ActiveRoutine;
+        void RoutineManager::TerminateRoutinesBasedOnUnlock(const Subsystem& subsystem) {
+            // Removed on the next update once they report finished
+            for (auto& routine : m_ActiveRoutines) {
+                if (!routine->IsFinished() && routine->ShouldTerminateBasedOnUnlock(subsystem)) {
+                    routine->Terminate();
+                    if (std::find(m_AwakeRoutines.begin(), m_AwakeRoutines.end(), routine.get()) == m_AwakeRoutines.end()) {
+                        WakeRoutine(*routine);
+                    }
+                }
+            }
+        }
+
+        void RoutineManager::TerminateAllRoutines() {
+            TerminateActiveRoutines();
+            while (!m_QueuedRoutines.IsEmpty()) {
+                m_QueuedRoutines.Pop()->Terminate();
+            }
+        }
+
+        void RoutineManager::Reset() {
+            m_ActiveRoutines.clear();
+            m_ActiveRoutineStartTimes.clear();
+            m_AwakeRoutines.clear();
+            m_EventRoutines.clear();
+            m_TimerWheel.Clear();
+            m_PendingEvents = 0;
+            m_QueuedRoutines.Clear();
+            m_ActiveRequirements = 0;
+            m_ShouldStartQueued = false;
+        }
+
+        void RoutineManager::TerminateActiveRoutines() {
+            for (auto& routine : m_ActiveRoutines) {
+                routine->Terminate();
+            }
+            m_ActiveRoutines.clear();
+            m_ActiveRoutineStartTimes.clear();
+            m_AwakeRoutines.clear();
+            m_EventRoutines.clear();
+            m_TimerWheel.Clear();
+            m_ActiveRequirements = 0;
+            m_ShouldStartQueued = true;
         }
     }
 }
@@ -0,0 +1,102 @@
+#include <lib/routine_tracer.hpp>
+
+#include <lib/logger.hpp>
+#include <lib/mpsc_ring_buffer.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+namespace garage {
+    namespace lib {
+        struct RoutineTraceEvent {
+            int64_t time, duration; // Nanoseconds
+            uint32_t runId;
+            RoutineTracer::EventType type;
+            char name[ROUTINE_TRACE_NAME_SIZE];
+        };
+
+        static MpscRingBuffer<RoutineTraceEvent, ROUTINE_TRACE_CAPACITY> s_Events;
+
+        std::atomic<bool> RoutineTracer::s_IsEnabled{false};
+        std::atomic<uint32_t> RoutineTracer::s_NextRunId{1};
+        std::atomic<unsigned long> RoutineTracer::s_DroppedEvents{0};
+
+        void RoutineTracer::Record(EventType type, const std::string& name, uint32_t runId, Clock::TimePoint time, Clock::Duration duration) {
+            const bool pushed = s_Events.TryPush([&](RoutineTraceEvent& event) {
+                event.time = time.time_since_epoch().count();
+                event.duration = duration.count();
+                event.runId = runId;
+                event.type = type;
+                const std::size_t length = std::min(name.size(), sizeof(event.name) - 1);
+                std::memcpy(event.name, name.data(), length);
+                event.name[length] = '\0';
+            });
+            if (!pushed) {
+                s_DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Names are written as JSON strings, only quotes, backslashes and control characters need escaping
+         */
+        static void WriteName(std::FILE* file, const char* name) {
+            std::fputc('"', file);
+            for (const char* character = name; *character; character++) {
+                if (*character == '"' || *character == '\\')
+                    std::fprintf(file, "\\%c", *character);
+                else if (static_cast<unsigned char>(*character) < 0x20)
+                    std::fprintf(file, "\\u%04x", *character);
+                else
+                    std::fputc(*character, file);
+            }
+            std::fputc('"', file);
+        }
+
+        bool RoutineTracer::Export(const std::string& path) {
+            std::FILE* file = std::fopen(path.c_str(), "w");
+            if (!file) {
+                Logger::Log(Logger::LogLevel::k_Error, "[Routine Tracer] Could not open {}: {}", path, std::strerror(errno));
+                return false;
+            }
+            // Runs are async spans keyed by their id, updates are complete slices on the loop thread so they nest by time
+            unsigned long eventCount = 0;
+            std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+            while (s_Events.TryPop([&](RoutineTraceEvent& event) {
+                if (eventCount++ > 0) std::fputs(",\n", file);
+                std::fputs("{\"name\":", file);
+                WriteName(file, event.name);
+                const double timestamp = event.time / 1000.0;
+                switch (event.type) {
+                    case EventType::k_Start:
+                        std::fprintf(file, ",\"cat\":\"routine\",\"ph\":\"b\",\"id\":%u,\"ts\":%.3f", event.runId, timestamp);
+                        break;
+                    case EventType::k_Update:
+                        std::fprintf(file, ",\"cat\":\"update\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", timestamp, event.duration / 1000.0);
+                        break;
+                    case EventType::k_Finish:
+                    case EventType::k_Terminate:
+                        std::fprintf(file, ",\"cat\":\"routine\",\"ph\":\"e\",\"id\":%u,\"ts\":%.3f,\"args\":{\"end\":\"%s\"}", event.runId, timestamp,
+                                     event.type == EventType::k_Finish ? "finished" : "terminated");
+                        break;
+                }
+                std::fputs(",\"pid\":1,\"tid\":1}", file);
+            })) {}
+            std::fputs("\n]}\n", file);
+            const bool isWritten = std::fclose(file) == 0;
+            const unsigned long dropped = s_DroppedEvents.exchange(0, std::memory_order_relaxed);
+            if (dropped > 0) {
+                Logger::Log(Logger::LogLevel::k_Warning, "[Routine Tracer] Queue was full, dropped {} events", dropped);
+            }
+            Logger::Log(Logger::LogLevel::k_Info, "[Routine Tracer] Wrote {} events to {}", eventCount, path);
+            return isWritten;
+        }
+
+        void RoutineTracer::Clear() {
+            while (s_Events.TryPop([](RoutineTraceEvent&) {})) {}
+            s_DroppedEvents = 0;
+        }
+    }
+}
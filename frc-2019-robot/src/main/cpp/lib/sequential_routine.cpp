@@ -21,6 +21,8 @@ namespace garage {
                         auto& nextRoutine = m_SubRoutines[m_CurrentRoutineIndex];
                         nextRoutine->Start();
                     }
+                } else {
+                    SleepWithChildren(&currentRoutine, &currentRoutine + 1);
                 }
             }
         }
@@ -8,7 +8,11 @@
 namespace garage {
     namespace lib {
         Subsystem::Subsystem(std::shared_ptr<Robot>& robot, const std::string& subsystemName)
-                : m_Robot(robot), m_NetworkTable(robot->GetNetworkTable()->GetSubTable(subsystemName)), m_SubsystemName(subsystemName) {
+                : m_Robot(robot), m_NetworkTable(robot->GetNetworkTable()->GetSubTable(subsystemName)), m_Profiler(robot->GetProfiler()),
+                  m_PeriodicPhase(m_Profiler.AddPhase(subsystemName + " Periodic")),
+                  m_SpacedUpdatePhase(m_Profiler.AddPhase(subsystemName + " Spaced Update")),
+                  m_UpdatePhase(m_Profiler.AddPhase(subsystemName + " Update")),
+                  m_SubsystemName(subsystemName), m_LogPrefix("[" + subsystemName + "] ") {
             Log(Logger::LogLevel::k_Info, "Subsystem Initialized");
         }
 
@@ -32,21 +36,32 @@ namespace garage {
             m_IsLocked = false;
         }
 
+        void Subsystem::SignalEvent() {
+            m_Robot->GetRoutineManager().SignalEvents(m_Requirement);
+        }
+
         void Subsystem::ResetUnlock() {
             Unlock();
         }
 
         void Subsystem::Periodic() {
-            auto command = m_Robot->GetLatestCommand();
-            if (m_IsLocked && ShouldUnlock(command)) {
-                auto activeRoutine = m_Robot->GetRoutineManager()->GetActiveRoutine().lock();
-                if (activeRoutine && activeRoutine->ShouldTerminateBasedOnUnlock(shared_from_this())) {
-                    activeRoutine->Terminate();
-                }
+            CheckUnlock();
+            RunPeriodic();
+        }
+
+        void Subsystem::CheckUnlock() {
+            if (m_IsLocked && ShouldUnlock(m_Robot->GetLatestCommand())) {
+                m_Robot->GetRoutineManager().TerminateRoutinesBasedOnUnlock(*this);
                 Unlock();
             }
+        }
+
+        void Subsystem::RunPeriodic() {
+            ProfilerScope periodicScope(m_Profiler, m_PeriodicPhase);
+            const Command& command = m_Robot->GetLatestCommand();
             AdvanceSequence();
             if (m_SequenceNumber % SPACED_UPDATE_INTERVAL == 0) {
+                ProfilerScope spacedUpdateScope(m_Profiler, m_SpacedUpdatePhase);
                 SpacedUpdate(command);
             }
             if (m_IsLocked) {
@@ -54,8 +69,10 @@ namespace garage {
             } else {
                 UpdateUnlocked(command);
             }
-            Update();
-            m_LastCommand = command;
+            {
+                ProfilerScope updateScope(m_Profiler, m_UpdatePhase);
+                Update();
+            }
         }
 
         void Subsystem::AdvanceSequence() {
@@ -66,15 +83,20 @@ namespace garage {
         }
 
         void Subsystem::Log(Logger::LogLevel logLevel, const std::string& log) {
-            Logger::Log(logLevel, Logger::Format("[%s] %s", m_SubsystemName.c_str(), log.c_str()));
+            Logger::LogWithPrefix(logLevel, m_LogPrefix, "{}", log);
         }
 
         void Subsystem::LogSample(Logger::LogLevel logLevel, const std::string& log, int frequency) {
-            if (m_SequenceNumber % frequency == 0)
+            if (Logger::IsEnabled(logLevel) && m_SequenceNumber % frequency == 0)
                 Log(logLevel, log);
         }
 
-        bool Subsystem::ShouldUnlock(Command& command) {
+        void Subsystem::RecordTelemetry(FlightRecorder& recorder, SubsystemTelemetry& telemetry) {
+            telemetry.isLocked = m_IsLocked;
+            FillTelemetry(telemetry);
+        }
+
+        bool Subsystem::ShouldUnlock(const Command& command) {
             return true;
         }
 
@@ -85,9 +107,8 @@ namespace garage {
                     [this, entryName, callback](const nt::EntryNotification& notification) {
                         const auto newValue = notification.value->GetDouble();
                         const bool success = callback(newValue);
-                        Log(Logger::LogLevel::k_Info,
-                            Logger::Format("%s %s value %s to %f", success ? "Successfully set" : "Error in setting",
-                                           FMT_STR(m_SubsystemName), FMT_STR(entryName), newValue));
+                        Log(Logger::LogLevel::k_Info, "{} {} value {} to {}", success ? "Successfully set" : "Error in setting",
+                            m_SubsystemName, entryName, newValue);
                     }, NT_NOTIFY_UPDATE);
         }
     }
@@ -0,0 +1,144 @@
+#include <lib/subsystem_worker_pool.hpp>
+
+#include <lib/logger.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+
+namespace garage {
+    namespace lib {
+        bool SubsystemWorkerPool::CreateJobs(const std::vector<std::shared_ptr<Subsystem>>& subsystems) {
+            std::vector<Subsystem*> ordered;
+            ordered.reserve(subsystems.size());
+            auto find = [&ordered](const Subsystem* subsystem) {
+                return static_cast<std::size_t>(std::find(ordered.begin(), ordered.end(), subsystem) - ordered.begin());
+            };
+            auto isGiven = [&subsystems](const Subsystem* subsystem) {
+                return std::any_of(subsystems.begin(), subsystems.end(),
+                                   [subsystem](const std::shared_ptr<Subsystem>& other) { return other.get() == subsystem; });
+            };
+            // Keeps the given order as much as possible, each pass places every subsystem whose dependencies already are
+            while (ordered.size() < subsystems.size()) {
+                bool placedAny = false;
+                for (const auto& subsystem : subsystems) {
+                    if (find(subsystem.get()) < ordered.size()) continue;
+                    const auto& dependencies = subsystem->GetDependencies();
+                    const bool isReady = std::all_of(dependencies.begin(), dependencies.end(), [&](const Subsystem* dependency) {
+                        return find(dependency) < ordered.size() || !isGiven(dependency);
+                    });
+                    if (isReady) {
+                        ordered.push_back(subsystem.get());
+                        placedAny = true;
+                    }
+                }
+                if (!placedAny) {
+                    Logger::Log(Logger::LogLevel::k_Error, "[Subsystem Workers] Subsystem dependencies have a cycle");
+                    return false;
+                }
+            }
+            m_Jobs.clear();
+            for (Subsystem* subsystem : ordered) {
+                Job job{subsystem, {}};
+                for (const Subsystem* dependency : subsystem->GetDependencies()) {
+                    const std::size_t index = find(dependency);
+                    if (index < ordered.size()) job.dependencies.push_back(index);
+                }
+                m_Jobs.push_back(std::move(job));
+            }
+            m_IsJobDone.reset(new std::atomic<bool>[m_Jobs.size()]);
+            for (std::size_t i = 0; i < m_Jobs.size(); i++) {
+                m_IsJobDone[i] = true;
+            }
+            return true;
+        }
+
+        bool SubsystemWorkerPool::Start(const std::vector<std::shared_ptr<Subsystem>>& subsystems, int workerCount) {
+            Stop();
+            if (!CreateJobs(subsystems)) return false;
+            unsigned long generation;
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_ShouldStop = false;
+                // Runs from before a restart already happened, new workers must only wake for the next one
+                generation = m_Generation;
+            }
+            const unsigned int coreCount = std::max(std::thread::hardware_concurrency(), 1u);
+            for (int i = 0; i < workerCount; i++) {
+                // The loop thread is usually on the first core, so workers start on the next one
+                m_Workers.emplace_back(&SubsystemWorkerPool::RunWorker, this, static_cast<int>((i + 1) % coreCount), generation);
+            }
+            Logger::Log(Logger::LogLevel::k_Info, "[Subsystem Workers] Started {} workers for {} subsystems", workerCount, m_Jobs.size());
+            return true;
+        }
+
+        void SubsystemWorkerPool::Stop() {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_ShouldStop = true;
+            }
+            m_StartCondition.notify_all();
+            for (auto& worker : m_Workers) {
+                worker.join();
+            }
+            m_Workers.clear();
+            m_Jobs.clear();
+        }
+
+        void SubsystemWorkerPool::RunWorker(int core, unsigned long generation) {
+            cpu_set_t cores;
+            CPU_ZERO(&cores);
+            CPU_SET(core, &cores);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores) != 0) {
+                Logger::Log(Logger::LogLevel::k_Warning, "[Subsystem Workers] Could not pin worker to core {}", core);
+            }
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    m_StartCondition.wait(lock, [&] { return m_ShouldStop || m_Generation != generation; });
+                    if (m_ShouldStop) return;
+                    generation = m_Generation;
+                }
+                RunJobs();
+            }
+        }
+
+        void SubsystemWorkerPool::Run() {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                for (std::size_t i = 0; i < m_Jobs.size(); i++) {
+                    m_IsJobDone[i].store(false, std::memory_order_relaxed);
+                }
+                m_RemainingJobs.store(m_Jobs.size(), std::memory_order_relaxed);
+                // Last, a worker still leaving the previous run must not take a job before the flags are reset
+                m_NextJob.store(0, std::memory_order_release);
+                m_Generation++;
+            }
+            m_StartCondition.notify_all();
+            RunJobs();
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_DoneCondition.wait(lock, [this] { return m_RemainingJobs.load(std::memory_order_acquire) == 0; });
+        }
+
+        void SubsystemWorkerPool::RunJobs() {
+            while (true) {
+                const std::size_t index = m_NextJob.fetch_add(1, std::memory_order_acq_rel);
+                if (index >= m_Jobs.size()) return;
+                Job& job = m_Jobs[index];
+                for (std::size_t dependency : job.dependencies) {
+                    // Dependencies were taken before this job, so they are already running somewhere
+                    while (!m_IsJobDone[dependency].load(std::memory_order_acquire)) {
+                        std::this_thread::yield();
+                    }
+                }
+                job.subsystem->RunPeriodic();
+                m_IsJobDone[index].store(true, std::memory_order_release);
+                if (m_RemainingJobs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock(m_Mutex);
+                    m_DoneCondition.notify_one();
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#include <lib/timeout_routine.hpp>
+
+#include <lib/logger.hpp>
+
+#include <algorithm>
+
+namespace garage {
+    namespace lib {
+        TimeoutRoutine::TimeoutRoutine(std::shared_ptr<Robot> robot, const std::shared_ptr<Routine>& routine, long timeoutMilliseconds,
+                                       const std::shared_ptr<Routine>& fallbackRoutine, const std::string& name)
+                : Routine(robot, name), m_Routine(routine), m_FallbackRoutine(fallbackRoutine), m_TimeoutMilliseconds(timeoutMilliseconds) {
+            m_Requirements |= m_Routine->GetRequirements();
+            if (m_FallbackRoutine) m_Requirements |= m_FallbackRoutine->GetRequirements();
+        }
+
+        void TimeoutRoutine::Start() {
+            Routine::Start();
+            m_IsTimedOut = false;
+            m_EndTime = m_Clock->Now() + m_TimeoutMilliseconds;
+            m_Routine->Start();
+        }
+
+        void TimeoutRoutine::Update() {
+            if (m_IsTimedOut) {
+                if (m_FallbackRoutine) {
+                    m_FallbackRoutine->Periodic();
+                    SleepWithChildren(&m_FallbackRoutine, &m_FallbackRoutine + 1);
+                }
+            } else if (!m_Routine->Periodic() && !m_Routine->IsFinished()) {
+                // Finishing on the same update as the timeout still counts
+                if (m_Clock->Now() > m_EndTime) {
+                    Logger::Log(Logger::LogLevel::k_Warning, "[{}] {} timed out after {} milliseconds, {}", m_Name, m_Routine->GetName(),
+                                m_TimeoutMilliseconds.count(), m_FallbackRoutine ? "running fallback" : "skipping");
+                    m_Routine->Terminate();
+                    m_IsTimedOut = true;
+                    if (m_FallbackRoutine) m_FallbackRoutine->Start();
+                } else if (m_Routine->IsSleeping()) {
+                    SleepUntil(std::min(m_Routine->GetWakeTime(), m_EndTime), m_Routine->GetWakeEvents());
+                }
+            }
+        }
+
+        bool TimeoutRoutine::CheckFinished() {
+            if (m_IsTimedOut)
+                return !m_FallbackRoutine || m_FallbackRoutine->IsFinished();
+            else
+                return m_Routine->IsFinished();
+        }
+
+        void TimeoutRoutine::Terminate() {
+            Routine::Terminate();
+            if (!m_Routine->IsFinished()) m_Routine->Terminate();
+            if (m_IsTimedOut && m_FallbackRoutine && !m_FallbackRoutine->IsFinished()) m_FallbackRoutine->Terminate();
+        }
+    }
+}
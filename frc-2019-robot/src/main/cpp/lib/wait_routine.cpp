@@ -6,12 +6,14 @@ namespace garage {
     namespace lib {
         void WaitRoutine::Start() {
             Routine::Start();
-            m_StartTime = std::chrono::system_clock::now();
+            m_StartTime = m_Clock->Now();
             m_EndTime = m_StartTime + m_DurationMilliseconds;
         }
 
         bool WaitRoutine::CheckFinished() {
-            return std::chrono::system_clock::now() > m_EndTime;
+            if (m_Clock->Now() > m_EndTime) return true;
+            SleepUntil(m_EndTime);
+            return false;
         }
     }
 }
\ No newline at end of file
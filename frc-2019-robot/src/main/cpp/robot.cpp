@@ -7,12 +7,25 @@
 #include <routine/reset_with_servo_routine.hpp>
 #include <routine/post_hatch_place_routine.hpp>
 
+#include <lib/routine_tracer.hpp>
 #include <lib/auto_routine_from_csv.hpp>
 
 #include <test/test_drive_auto_routine.hpp>
 
 #include <frc/DriverStation.h>
 
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#include <ctime>
+#include <cstdio>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+
+#define RECORDING_NUMBER_DIGITS 6
+
 namespace garage {
     void Robot::RobotInit() {
         lib::Logger::Log(lib::Logger::LogLevel::k_Info, "Start robot initialization");
@@ -24,12 +37,21 @@ namespace garage {
         m_DashboardNetworkTable = m_NetworkTable->GetSubTable("Dashboard");
         /* Setup logging system */
         lib::Logger::SetLogLevel(m_Config.logLevel);
+        if (m_Config.asyncLogging) lib::Logger::StartAsync();
         m_NetworkTable->PutNumber("Log Level", static_cast<double>(m_Config.logLevel));
         m_NetworkTable->GetEntry("Log Level").AddListener([&](const nt::EntryNotification& notification) {
             auto logLevel = static_cast<lib::Logger::LogLevel>(std::lround(notification.value->GetDouble()));
             lib::Logger::SetLogLevel(logLevel);
-            lib::Logger::Log(lib::Logger::LogLevel::k_Info, lib::Logger::Format("Updated log level to: %d", logLevel));
+            lib::Logger::Log(lib::Logger::LogLevel::k_Info, "Updated log level to: {}", logLevel);
         }, NT_NOTIFY_UPDATE);
+        /* Setup profiler, subsystems add their own phases */
+        m_Profiler.Initialize(m_NetworkTable->GetSubTable("Profiler"));
+        m_Profiler.SetEnabled(m_Config.enableProfiler);
+        m_LoopPhase = m_Profiler.AddPhase("Loop");
+        m_UpdateCommandPhase = m_Profiler.AddPhase("Update Command");
+        m_RoutineManagerPhase = m_Profiler.AddPhase("Routine Manager");
+        m_SubsystemsPhase = m_Profiler.AddPhase("Subsystems");
+        m_FlightRecorderPhase = m_Profiler.AddPhase("Flight Recorder");
         // Technically this is bad since we are a stack object, but we do not have access to the creation
         // of our class, so this is one of the only ways we can get a shared pointer.
         // It will be destroyed when it goes out of scope but by then everything should be cleaned up.
@@ -37,18 +59,22 @@ namespace garage {
         /* Setup routine manager */
         m_RoutineManager = std::make_shared<lib::RoutineManager>(m_Pointer);
         /* Manage subsystems */
-        if (m_Config.enableElevator) AddSubsystem(m_Elevator = std::make_shared<Elevator>(m_Pointer));
-        if (m_Config.enableDrive) AddSubsystem(m_Drive = std::make_shared<Drive>(m_Pointer));
-        if (m_Config.enableFlipper) AddSubsystem(m_Flipper = std::make_shared<Flipper>(m_Pointer));
-        if (m_Config.enableBallIntake) AddSubsystem(m_BallIntake = std::make_shared<BallIntake>(m_Pointer));
-        if (m_Config.enableHatchIntake) AddSubsystem(m_HatchIntake = std::make_shared<HatchIntake>(m_Pointer));
-        if (m_Config.enableOutrigger) AddSubsystem(m_Outrigger = std::make_shared<Outrigger>(m_Pointer));
+        if (m_Config.enableElevator) m_Subsystems.Create<Elevator>(m_Pointer);
+        if (m_Config.enableDrive) m_Subsystems.Create<Drive>(m_Pointer);
+        if (m_Config.enableFlipper) m_Subsystems.Create<Flipper>(m_Pointer);
+        if (m_Config.enableBallIntake) m_Subsystems.Create<BallIntake>(m_Pointer);
+        if (m_Config.enableHatchIntake) m_Subsystems.Create<HatchIntake>(m_Pointer);
+        if (m_Config.enableOutrigger) m_Subsystems.Create<Outrigger>(m_Pointer);
+        SetParallelSubsystems(m_Config.enableParallelSubsystems);
         /* Create our routines */
         CreateRoutines();
+        if (m_Config.enableFlightRecorder) OpenFlightRecorder();
+        if (m_Config.enableCommandLog) OpenCommandLog();
+        lib::RoutineTracer::SetEnabled(m_Config.enableRoutineTracer);
         // Find out how long initialization took and record it
         auto end = std::chrono::high_resolution_clock::now();
         auto initializationTime = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin);
-        lib::Logger::Log(lib::Logger::LogLevel::k_Info, lib::Logger::Format("End robot initialization, took %d milliseconds", initializationTime));
+        lib::Logger::Log(lib::Logger::LogLevel::k_Info, "End robot initialization, took {} milliseconds", initializationTime);
     }
 
     void Robot::CreateRoutines() {
@@ -57,14 +83,29 @@ namespace garage {
 //        m_DriveForwardRoutine->CalculatePath();
         m_ResetWithServoRoutine = std::make_shared<ResetWithServoRoutine>(m_Pointer);
         /* Utility routines */
-        m_GroundBallIntakeRoutine = std::make_shared<BallIntakeRoutine>(m_Pointer, m_Config.groundIntakeBallHeight, FLIPPER_UPPER_ANGLE);
-        m_LoadingBallIntakeRoutine = std::make_shared<BallIntakeRoutine>(m_Pointer, m_Config.loadingIntakeBallHeight, FLIPPER_UPPER_ANGLE);
+        m_BallIntakeRoutines = std::make_shared<lib::RoutinePool<BallIntakeRoutine, 1>>(m_Pointer, m_Config.groundIntakeBallHeight, FLIPPER_UPPER_ANGLE);
         m_PostHatchPlacementRoutine = std::make_shared<PostHatchPlaceRoutine>(m_Pointer);
         /* End game routines */
         m_EndGameRoutine = std::make_shared<LockFlipperRoutine>(m_Pointer);
-        m_SecondLevelClimbRoutine = std::make_shared<ClimbHabRoutine>(m_Pointer, m_Config.secondLevelClimbHeight);
-        m_ThirdLevelClimbRoutine = std::make_shared<ClimbHabRoutine>(m_Pointer, m_Config.thirdLevelClimbHeight);
+        m_ClimbHabRoutines = std::make_shared<lib::RoutinePool<ClimbHabRoutine, 1>>(m_Pointer, m_Config.secondLevelClimbHeight);
         m_StowFlipperRoutine = std::make_shared<ElevatorAndFlipperRoutine>(m_Pointer, 0.0, 70.0);
+        // Backing away after placing a hatch can not wait, long resets and end game routines give way to the drivers
+        m_PostHatchPlacementRoutine->SetPriority(lib::Routine::Priority::k_High);
+        for (auto& routine : {m_ResetWithServoRoutine, m_EndGameRoutine}) {
+            routine->SetPriority(lib::Routine::Priority::k_Low);
+        }
+        for (auto& routine : m_ClimbHabRoutines->GetRoutines()) {
+            routine->SetPriority(lib::Routine::Priority::k_Low);
+        }
+        // In the order of the command routine values, which the command log checks a replay against
+        const std::shared_ptr<lib::Routine>
+                &ballIntakeRoutine = m_BallIntakeRoutines->GetRoutines().front(),
+                &climbHabRoutine = m_ClimbHabRoutines->GetRoutines().front();
+        m_CommandRoutineNames.clear();
+        for (auto& routine : {m_ResetWithServoRoutine, ballIntakeRoutine, ballIntakeRoutine, m_PostHatchPlacementRoutine,
+                              m_EndGameRoutine, climbHabRoutine, climbHabRoutine, m_StowFlipperRoutine}) {
+            m_CommandRoutineNames.push_back(routine->GetName());
+        }
 //        // Testing routines
 //        auto
 //                testWaitRoutineOne = std::make_shared<lib::WaitRoutine>(m_Pointer, 500l),
@@ -77,14 +118,108 @@ namespace garage {
 //        m_TestRoutine = std::make_shared<TimedDriveRoutine>(m_Pointer, 1000l, 0.1, "Meme");
     }
 
+    std::shared_ptr<lib::Routine> Robot::GetCommandRoutine(CommandRoutine routine) {
+        switch (routine) {
+            case CommandRoutine::k_ResetWithServo:
+                return m_ResetWithServoRoutine;
+            case CommandRoutine::k_GroundBallIntake:
+            case CommandRoutine::k_LoadingBallIntake: {
+                if (!m_BallIntakeRoutines->GetAvailableCount()) return m_BallIntakeRoutines->GetRoutines().front();
+                const double height = routine == CommandRoutine::k_GroundBallIntake
+                                      ? m_Config.groundIntakeBallHeight : m_Config.loadingIntakeBallHeight;
+                return m_BallIntakeRoutines->Acquire(height, FLIPPER_UPPER_ANGLE);
+            }
+            case CommandRoutine::k_PostHatchPlacement:
+                return m_PostHatchPlacementRoutine;
+            case CommandRoutine::k_EndGame:
+                return m_EndGameRoutine;
+            case CommandRoutine::k_SecondLevelClimb:
+            case CommandRoutine::k_ThirdLevelClimb: {
+                if (!m_ClimbHabRoutines->GetAvailableCount()) return m_ClimbHabRoutines->GetRoutines().front();
+                const double height = routine == CommandRoutine::k_SecondLevelClimb
+                                      ? m_Config.secondLevelClimbHeight : m_Config.thirdLevelClimbHeight;
+                return m_ClimbHabRoutines->Acquire(height);
+            }
+            case CommandRoutine::k_StowFlipper:
+                return m_StowFlipperRoutine;
+        }
+        return nullptr;
+    }
+
+    std::string Robot::CreateRecordingPath(const std::string& directory, const std::string& prefix, const char* extension,
+                                           unsigned int keepCount) {
+        mkdir(directory.c_str(), 0755);
+        // Only names with a number of the right width, the zero padding makes them sort in the order they were made
+        std::vector<std::string> fileNames;
+        if (DIR* recordingDirectory = opendir(directory.c_str())) {
+            while (dirent* entry = readdir(recordingDirectory)) {
+                const std::string fileName = entry->d_name;
+                if (fileName.size() > prefix.size() + RECORDING_NUMBER_DIGITS && fileName.compare(0, prefix.size(), prefix) == 0 &&
+                    fileName[prefix.size() + RECORDING_NUMBER_DIGITS] == '_') {
+                    fileNames.push_back(fileName);
+                }
+            }
+            closedir(recordingDirectory);
+        }
+        std::sort(fileNames.begin(), fileNames.end());
+        // Numbered instead of going by date since the clock is only set once the driver station connects
+        const unsigned long number = fileNames.empty() ? 0 : std::strtoul(fileNames.back().c_str() + prefix.size(), nullptr, 10) + 1;
+        const std::size_t keptCount = std::max(keepCount, 1u) - 1;
+        for (std::size_t i = 0; i + keptCount < fileNames.size(); i++) {
+            const std::string path = directory + "/" + fileNames[i];
+            if (unlink(path.c_str()) == 0) {
+                lib::Logger::Log(lib::Logger::LogLevel::k_Info, "Removed old recording {}", path);
+            } else {
+                lib::Logger::Log(lib::Logger::LogLevel::k_Warning, "Could not remove old recording {}", path);
+            }
+        }
+        // The date may not be real for the same reason, but helps with telling them apart
+        char date[32];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y%m%d_%H%M%S", std::localtime(&now));
+        char fileName[128];
+        std::snprintf(fileName, sizeof(fileName), "%s%0*lu_%s%s", prefix.c_str(), RECORDING_NUMBER_DIGITS, number, date, extension);
+        return directory + "/" + fileName;
+    }
+
+    void Robot::OpenFlightRecorder() {
+        const std::string path = CreateRecordingPath(m_Config.flightRecorderDirectory, "flight_", ".bin", m_Config.flightRecorderFileCount);
+        m_FlightRecorder.Open(path, m_Subsystems.GetAll(), m_Clock);
+    }
+
+    void Robot::OpenCommandLog() {
+        const std::string path = CreateRecordingPath(m_Config.commandLogDirectory, "commands_", ".bin", m_Config.commandLogFileCount);
+        m_CommandLog.Open(path, m_CommandRoutineNames, m_Clock);
+    }
+
+    void Robot::ExportRoutineTrace() {
+        char fileName[64];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(fileName, sizeof(fileName), "trace_%Y%m%d_%H%M%S.json", std::localtime(&now));
+        const std::string directory = m_Config.routineTraceDirectory;
+        mkdir(directory.c_str(), 0755);
+        lib::RoutineTracer::Export(directory + "/" + fileName);
+    }
+
     void Robot::AddSubsystem(std::shared_ptr<lib::Subsystem> subsystem) {
-        m_Subsystems.push_back(subsystem);
-        subsystem->PostInitialize();
+        m_SubsystemWorkers.Stop();
+        m_Subsystems.AddDynamic(subsystem);
+    }
+
+    void Robot::SetParallelSubsystems(bool isParallel) {
+        if (isParallel) {
+            m_SubsystemWorkers.Start(m_Subsystems.GetAll(), m_Config.subsystemWorkerCount);
+        } else {
+            m_SubsystemWorkers.Stop();
+        }
     }
 
     void Robot::RobotPeriodic() {}
 
     void Robot::DisabledInit() {
+        m_FlightRecorder.Flush();
+        m_CommandLog.Flush();
+        if (lib::RoutineTracer::IsEnabled()) ExportRoutineTrace();
         m_LimeLight.SetLedMode(lib::Limelight::LedMode::k_Off);
         SetLedMode(LedMode::k_Idle);
     }
@@ -103,11 +238,11 @@ namespace garage {
         m_LimeLight.SetLedMode(lib::Limelight::LedMode::k_Off);
         SetLedMode(LedMode::k_Idle);
         m_LastPeriodicTime.reset();
-        m_Command = {};
+        m_Commands = {};
+        m_RoutineRequests.clear();
+        m_CommandLog.MarkReset();
         m_RoutineManager->Reset();
-        for (const auto& subsystem : m_Subsystems) {
-            subsystem->Reset();
-        }
+        m_Subsystems.ForEach([](auto& subsystem) { subsystem.Reset(); });
     }
 
     void Robot::TeleopInit() {
@@ -115,75 +250,138 @@ namespace garage {
     }
 
     void Robot::ControllablePeriodic() {
+        lib::ProfilerScope loopScope(m_Profiler, m_LoopPhase);
+        CheckLoopTime();
+        {
+            lib::ProfilerScope updateCommandScope(m_Profiler, m_UpdateCommandPhase);
+            UpdateCommand();
+        }
+        RunCommand();
+    }
+
+    void Robot::ReplayPeriodic(const Command& command, const RoutineRequests& routines) {
+        lib::ProfilerScope loopScope(m_Profiler, m_LoopPhase);
+        CheckLoopTime();
+        m_CommandIndex ^= 1;
+        m_Commands[m_CommandIndex] = command;
+        m_RoutineRequests = routines;
+        RunCommand();
+    }
+
+    void Robot::CheckLoopTime() {
         // See if we are taking too much time and not getting fifty updates a second
-        auto now = std::chrono::system_clock::now();
+        auto now = m_Clock->Now();
         if (m_LastPeriodicTime) {
             auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_LastPeriodicTime.value());
             if (delta > m_Period * 1.05) {
-                lib::Logger::Log(lib::Logger::LogLevel::k_Warning,
-                                 lib::Logger::Format("Loop was more than five percent of expected, took %d milliseconds", delta));
+                lib::Logger::Log(lib::Logger::LogLevel::k_Warning, "Loop was more than five percent of expected, took {} milliseconds", delta);
             }
         }
         m_LastPeriodicTime = now;
-        UpdateCommand();
-        if (m_EndRumble && std::chrono::system_clock::now() >= m_EndRumble) {
+    }
+
+    void Robot::RunCommand() {
+        const Command& command = GetLatestCommand();
+        m_CommandLog.Record(command, m_RoutineRequests);
+        ExecuteCommand();
+        if (m_EndRumble && m_Clock->Now() >= m_EndRumble) {
             SetControllerRumbles(0.0);
             m_EndRumble.reset();
         }
-        m_RoutineManager->AddRoutinesFromCommand(m_Command);
-        m_RoutineManager->Update();
-        for (const auto& subsystem : m_Subsystems) {
-            subsystem->Periodic();
+        for (const CommandRoutine routine : m_RoutineRequests) {
+            m_RoutineManager->AddRoutine(GetCommandRoutine(routine));
+        }
+        {
+            lib::ProfilerScope routineManagerScope(m_Profiler, m_RoutineManagerPhase);
+            m_RoutineManager->Update();
         }
+        UpdateSubsystems();
+        {
+            lib::ProfilerScope flightRecorderScope(m_Profiler, m_FlightRecorderPhase);
+            m_FlightRecorder.Record(command, m_RoutineManager->GetActiveRoutines(), m_Subsystems.GetAll());
+        }
+        m_Profiler.EndLoop();
 //        m_DashboardNetworkTable->PutNumber("Match Time Remaining", frc::DriverStation::GetInstance().GetMatchTime());
     }
 
-    void Robot::TeleopPeriodic() {
-        ControllablePeriodic();
+    void Robot::UpdateSubsystems() {
+        lib::ProfilerScope subsystemsScope(m_Profiler, m_SubsystemsPhase);
+        if (m_SubsystemWorkers.IsRunning()) {
+            // Unlocking ends routines, which can touch any subsystem, so it is done for all of them before any update
+            m_Subsystems.ForEach([](auto& subsystem) { subsystem.CheckUnlock(); });
+            m_SubsystemWorkers.Run();
+        } else {
+            m_Subsystems.ForEach([](auto& subsystem) { subsystem.Periodic(); });
+        }
     }
 
-    void Robot::UpdateCommand() {
-        /* Routines */
-        m_Command.routines.clear();
-        if (m_PrimaryController.GetBackButtonPressed() || m_SecondaryController.GetBackButtonPressed()) {
+    void Robot::ExecuteCommand() {
+        const Command& command = GetLatestCommand();
+        const auto& drive = GetSubsystem<Drive>();
+        const auto& flipper = GetSubsystem<Flipper>();
+        const auto& elevator = GetSubsystem<Elevator>();
+        if (command.terminateRoutines) {
             m_RoutineManager->TerminateAllRoutines();
         }
-        if (m_PrimaryController.GetStartButtonPressed() || m_SecondaryController.GetStartButtonPressed()) {
-            m_Command.routines.push_back(m_StowFlipperRoutine);
-//            m_Command.routines.push_back(m_TestRoutine);
-//            m_Command.offTheBooksModeEnabled = !m_Command.offTheBooksModeEnabled;
-//            if (m_Command.offTheBooksModeEnabled) {
-//                m_Command.routines.push_back(m_EndGameRoutine);
-//            } else {
-//                m_Command.routines.push_back(m_ResetWithServoRoutine);
-//            }
-        }
-        /* Four buttons */
-        if (m_Drive) {
-            if (m_PrimaryController.GetAButton() || m_SecondaryController.GetAButton()) {
+        if (drive) {
+            if (command.autoAlign) {
                 if (m_LimeLight.HasTarget()) {
-                    m_Drive->AutoAlign();
+                    drive->AutoAlign();
                     SetLedMode(LedMode::k_HasTarget);
                 } else {
                     SetLedMode(LedMode::k_NoTarget);
                 }
             }
-            if (m_PrimaryController.GetAButtonReleased() || m_SecondaryController.GetAButtonReleased()) {
-                m_Drive->Unlock();
+            if (command.autoAlignReleased) {
+                drive->Unlock();
                 SetLedMode(LedMode::k_Idle);
                 m_LimeLight.SetLedMode(lib::Limelight::LedMode::k_Off);
             }
-            if (m_PrimaryController.GetAButtonPressed() || m_SecondaryController.GetAButtonPressed()) {
+            if (command.autoAlignPressed) {
                 m_LimeLight.SetLedMode(lib::Limelight::LedMode::k_On);
             }
         }
+        if (flipper && command.hasFlipperAngle) {
+            flipper->SetAngle(command.flipperAngle);
+        }
+        if (elevator && command.hasElevatorSetPoint) {
+            elevator->SetWantedSetPoint(command.elevatorSetPoint);
+        }
+    }
+
+    void Robot::TeleopPeriodic() {
+        ControllablePeriodic();
+    }
+
+    void Robot::UpdateCommand() {
+        // Written over the older of the two, starting from the latest for anything that carries over
+        Command& command = m_Commands[m_CommandIndex ^ 1];
+        command = m_Commands[m_CommandIndex];
+        const auto& flipper = GetSubsystem<Flipper>();
+        const auto& elevator = GetSubsystem<Elevator>();
+        /* Routines */
+        m_RoutineRequests.clear();
+        command.terminateRoutines = m_PrimaryController.GetBackButtonPressed() || m_SecondaryController.GetBackButtonPressed();
+        if (m_PrimaryController.GetStartButtonPressed() || m_SecondaryController.GetStartButtonPressed()) {
+            m_RoutineRequests.push_back(CommandRoutine::k_StowFlipper);
+//            m_RoutineRequests.push_back(m_TestRoutine);
+//            command.offTheBooksModeEnabled = !command.offTheBooksModeEnabled;
+//            if (command.offTheBooksModeEnabled) {
+//                m_RoutineRequests.push_back(CommandRoutine::k_EndGame);
+//            } else {
+//                m_RoutineRequests.push_back(CommandRoutine::k_ResetWithServo);
+//            }
+        }
+        /* Four buttons */
+        command.autoAlign = m_PrimaryController.GetAButton() || m_SecondaryController.GetAButton();
+        command.autoAlignReleased = m_PrimaryController.GetAButtonReleased() || m_SecondaryController.GetAButtonReleased();
+        command.autoAlignPressed = m_PrimaryController.GetAButtonPressed() || m_SecondaryController.GetAButtonPressed();
         if (m_PrimaryController.GetBButtonPressed() || m_SecondaryController.GetBButtonPressed()) {
-            m_Command.routines.push_back(m_GroundBallIntakeRoutine);
+            m_RoutineRequests.push_back(CommandRoutine::k_GroundBallIntake);
         }
-        if (m_Flipper) {
-            if (m_PrimaryController.GetXButtonPressed() || m_SecondaryController.GetXButtonPressed()) {
-                m_Flipper->SetAngle(m_Flipper->GetAngle() > FLIPPER_STOW_ANGLE ? FLIPPER_LOWER_ANGLE : FLIPPER_UPPER_ANGLE);
-            }
+        command.hasFlipperAngle = flipper && (m_PrimaryController.GetXButtonPressed() || m_SecondaryController.GetXButtonPressed());
+        if (command.hasFlipperAngle) {
+            command.flipperAngle = flipper->GetAngle() > FLIPPER_STOW_ANGLE ? FLIPPER_LOWER_ANGLE : FLIPPER_UPPER_ANGLE;
         }
         const int primaryPOV = m_PrimaryController.GetPOV(), secondaryPOV = m_SecondaryController.GetPOV();
         const bool
@@ -193,50 +391,55 @@ namespace garage {
                 elevatorStow = primaryPOV == 0 || secondaryPOV == 0 || secondaryPOV == 45 || secondaryPOV == 315,
                 modButton = secondaryPOV == 90;
         /* DPad */
-        if (m_Elevator) {
+        command.hasElevatorSetPoint = false;
+        if (elevator) {
             // TODO hash map maybe?
+            command.hasElevatorSetPoint = true;
             if (elevatorDown) {
-                m_Elevator->SetWantedSetPoint(0.0);
+                command.elevatorSetPoint = 0.0;
             } else if (elevatorStow || m_ButtonBoard.GetRawButtonPressed(7)) {
-                m_Elevator->SetWantedSetPoint(m_Config.bottomHatchHeight);
+                command.elevatorSetPoint = m_Config.bottomHatchHeight;
             } else if (m_ButtonBoard.GetRawButtonPressed(1)) {
-                m_Elevator->SetWantedSetPoint(m_Config.rocketMiddleHatchHeight);
+                command.elevatorSetPoint = m_Config.rocketMiddleHatchHeight;
             } else if (m_ButtonBoard.GetRawButtonPressed(2)) {
-                m_Elevator->SetWantedSetPoint(m_Config.rocketTopHatchHeight);
+                command.elevatorSetPoint = m_Config.rocketTopHatchHeight;
             } else if (m_ButtonBoard.GetRawButtonPressed(8)) {
-                m_Elevator->SetWantedSetPoint(m_Config.rocketBottomBallHeight);
+                command.elevatorSetPoint = m_Config.rocketBottomBallHeight;
             } else if (m_ButtonBoard.GetRawButtonPressed(5)) {
-                m_Elevator->SetWantedSetPoint(m_Config.rocketMiddleBallHeight);
+                command.elevatorSetPoint = m_Config.rocketMiddleBallHeight;
             } else if (m_ButtonBoard.GetRawButtonPressed(4)) {
-                m_Elevator->SetWantedSetPoint(m_Config.rocketTopBallHeight);
+                command.elevatorSetPoint = m_Config.rocketTopBallHeight;
+            } else {
+                command.hasElevatorSetPoint = false;
             }
         }
         const bool secondaryY = m_SecondaryController.GetYButtonPressed();
-        m_Command.hatchIntakeDown = m_PrimaryController.GetYButtonPressed() || (secondaryY && !modButton);
+        command.hatchIntakeDown = m_PrimaryController.GetYButtonPressed() || (secondaryY && !modButton);
         if (secondaryY && modButton) {
-            m_Command.routines.push_back(m_PostHatchPlacementRoutine);
+            m_RoutineRequests.push_back(CommandRoutine::k_PostHatchPlacement);
         }
-        double wantedAngle = m_Flipper ? m_Flipper->GetWantedAngle() : FLIPPER_UPPER_ANGLE;
+        // The flipper is only told about a new angle when the command is executed, so look ahead to it
+        double wantedAngle = flipper ? (command.hasFlipperAngle ? command.flipperAngle : flipper->GetWantedAngle()) : FLIPPER_UPPER_ANGLE;
         const bool shouldInvertDrive = wantedAngle < FLIPPER_STOW_ANGLE;
         /* Joysticks */
-        m_Command.driveForward = math::threshold(-m_PrimaryController.GetY(frc::GenericHID::JoystickHand::kRightHand), DEFAULT_INPUT_THRESHOLD);
-        m_Command.driveTurn = math::threshold(m_PrimaryController.GetX(frc::GenericHID::JoystickHand::kRightHand), DEFAULT_INPUT_THRESHOLD);
-        m_Command.driveForward += math::threshold(-m_SecondaryController.GetY(frc::GenericHID::kRightHand), XBOX_360_STICK_INPUT_THRESHOLD) * 0.25;
-        m_Command.driveTurn += math::threshold(m_SecondaryController.GetX(frc::GenericHID::kRightHand), XBOX_360_STICK_INPUT_THRESHOLD) * 0.25;
+        command.driveForward = math::threshold(-m_PrimaryController.GetY(frc::GenericHID::JoystickHand::kRightHand), DEFAULT_INPUT_THRESHOLD);
+        command.driveTurn = math::threshold(m_PrimaryController.GetX(frc::GenericHID::JoystickHand::kRightHand), DEFAULT_INPUT_THRESHOLD);
+        command.driveForward += math::threshold(-m_SecondaryController.GetY(frc::GenericHID::kRightHand), XBOX_360_STICK_INPUT_THRESHOLD) * 0.25;
+        command.driveTurn += math::threshold(m_SecondaryController.GetX(frc::GenericHID::kRightHand), XBOX_360_STICK_INPUT_THRESHOLD) * 0.25;
 //        const auto px = m_PrimaryController.GetX(frc::GenericHID::kRightHand), sx = m_SecondaryController.GetX(frc::GenericHID::kRightHand);
-//        lib::Logger::Log(lib::Logger::LogLevel::k_Info, lib::Logger::Format("%f, %f, %f, %f, %f", px, math::threshold(px, 0.225), sx, math::threshold(sx, 0.225), m_Command.driveTurn));
+//        lib::Logger::Log(lib::Logger::LogLevel::k_Info, lib::Logger::Format("%f, %f, %f, %f, %f", px, math::threshold(px, 0.225), sx, math::threshold(sx, 0.225), command.driveTurn));
         // When we are flipped over invert the driving controls to make it feel natural
         if (shouldInvertDrive) {
-            m_Command.driveForward *= -1;
+            command.driveForward *= -1;
         }
-        m_Command.elevatorInput = math::threshold(-m_PrimaryController.GetY(frc::GenericHID::kLeftHand), DEFAULT_INPUT_THRESHOLD);
-        m_Command.elevatorInput += math::threshold(-m_SecondaryController.GetY(frc::GenericHID::kLeftHand), XBOX_360_STICK_INPUT_THRESHOLD) * 0.7;
+        command.elevatorInput = math::threshold(-m_PrimaryController.GetY(frc::GenericHID::kLeftHand), DEFAULT_INPUT_THRESHOLD);
+        command.elevatorInput += math::threshold(-m_SecondaryController.GetY(frc::GenericHID::kLeftHand), XBOX_360_STICK_INPUT_THRESHOLD) * 0.7;
         /* Triggers */
         double triggers = math::threshold(
                 m_SecondaryController.GetTriggerAxis(frc::GenericHID::JoystickHand::kRightHand) -
                 m_SecondaryController.GetTriggerAxis(frc::GenericHID::JoystickHand::kLeftHand), DEFAULT_INPUT_THRESHOLD);
         triggers = math::clamp(triggers, -1.0, 1.0);
-        m_Command.isQuickTurn = m_PrimaryController.GetTriggerAxis(frc::GenericHID::kLeftHand) > 0.35;
+        command.isQuickTurn = m_PrimaryController.GetTriggerAxis(frc::GenericHID::kLeftHand) > 0.35;
         /* Bumpers */
         auto bumpers = math::axis<double>(
                 m_PrimaryController.GetBumper(frc::GenericHID::JoystickHand::kRightHand),
@@ -247,21 +450,22 @@ namespace garage {
         bumpers = math::clamp(bumpers, -1.0, 1.0);
         /* Off the books */
 //        if (m_ButtonBoard.GetRawButtonPressed(6)) {
-//            m_Command.routines.push_back(m_SecondLevelClimbRoutine);
+//            m_RoutineRequests.push_back(CommandRoutine::k_SecondLevelClimb);
 //        } else if (m_ButtonBoard.GetRawButtonPressed(3)) {
-//            m_Command.routines.push_back(m_ThirdLevelClimbRoutine);
+//            m_RoutineRequests.push_back(CommandRoutine::k_ThirdLevelClimb);
 //        }
-        if (m_Command.offTheBooksModeEnabled) {
-            m_Command.outrigger = triggers;
-            m_Command.outriggerWheel = bumpers;
-            m_Command.ballIntake = 0;
-            m_Command.flipper = 0;
+        if (command.offTheBooksModeEnabled) {
+            command.outrigger = triggers;
+            command.outriggerWheel = bumpers;
+            command.ballIntake = 0;
+            command.flipper = 0;
         } else {
-            m_Command.outrigger = 0;
-            m_Command.outriggerWheel = 0;
-            m_Command.ballIntake = bumpers;
-            m_Command.flipper = triggers;
+            command.outrigger = 0;
+            command.outriggerWheel = 0;
+            command.ballIntake = bumpers;
+            command.flipper = triggers;
         }
+        m_CommandIndex ^= 1;
     }
 
     void Robot::TestInit() {
@@ -280,39 +484,9 @@ namespace garage {
             m_LedModule.Transaction(&ledModeInt, 1, nullptr, 0);
         }
     }
-
-    template<>
-    std::shared_ptr<Elevator> Robot::GetSubsystem() {
-        return m_Elevator;
-    }
-
-    template<>
-    std::shared_ptr<Drive> Robot::GetSubsystem() {
-        return m_Drive;
-    }
-
-    template<>
-    std::shared_ptr<Flipper> Robot::GetSubsystem() {
-        return m_Flipper;
-    }
-
-    template<>
-    std::shared_ptr<BallIntake> Robot::GetSubsystem() {
-        return m_BallIntake;
-    }
-
-    template<>
-    std::shared_ptr<Outrigger> Robot::GetSubsystem() {
-        return m_Outrigger;
-    }
-
-    template<>
-    std::shared_ptr<HatchIntake> Robot::GetSubsystem() {
-        return m_HatchIntake;
-    }
 }
 
-#ifndef RUNNING_FRC_TESTS
+#if !defined(RUNNING_FRC_TESTS) && !defined(GARAGE_SIMULATION)
 
 int main() {
     return frc::StartRobot<garage::Robot>();
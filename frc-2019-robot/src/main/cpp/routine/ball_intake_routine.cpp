@@ -2,6 +2,8 @@
 
 #include <robot.hpp>
 
+#include <lib/timeout_routine.hpp>
+
 namespace garage {
     IntakeBallUntilIn::IntakeBallUntilIn(std::shared_ptr<Robot> robot)
             : SubsystemRoutine(robot, "Intake Ball Until In") {
@@ -10,20 +12,16 @@ namespace garage {
 
     void IntakeBallUntilIn::Start() {
         Routine::Start();
-        if (m_Subsystem) {
-            m_Subsystem->Intake();
-        }
+        m_Subsystem->Intake();
     }
 
     bool IntakeBallUntilIn::CheckFinished() {
-        return m_Subsystem ? m_Subsystem->HasBall() : true;
+        return m_Subsystem->HasBall();
     }
 
     void IntakeBallUntilIn::Terminate() {
         Routine::Terminate();
-        if (m_Subsystem) {
-            m_Subsystem->Unlock();
-        }
+        m_Subsystem->Unlock();
     }
 
     void BallIntakeRoutine::Start() {
@@ -36,13 +34,17 @@ namespace garage {
         m_Robot->SetLedMode(Robot::LedMode::k_Idle);
     }
 
-    BallIntakeRoutine::BallIntakeRoutine(std::shared_ptr<Robot> robot, double setPoint, double angle) : SequentialRoutine(robot, "Intake Ball", {
-            // TODO tune values
-            std::make_shared<ElevatorAndFlipperRoutine>(robot, setPoint, angle, "Flipper Ball Intake"),
-            std::make_shared<IntakeBallUntilIn>(robot)
-//            std::make_shared<lib::WaitRoutine>(robot, 200l),
-//            std::make_shared<ElevatorAndFlipperRoutine>(robot, 0, FLIPPER_LOWER_ANGLE, "Reset")
-    }) {
-
+    BallIntakeRoutine::BallIntakeRoutine(std::shared_ptr<Robot> robot, double setPoint, double angle)
+            : SequentialRoutine(robot, "Intake Ball", {}),
+              m_ElevatorAndFlipperRoutine(std::make_shared<ElevatorAndFlipperRoutine>(robot, setPoint, angle, "Flipper Ball Intake")) {
+        // Built here so the set point routine can be kept for rebinding
+        m_SubRoutines = {
+                // TODO tune values
+                std::make_shared<lib::TimeoutRoutine>(robot, m_ElevatorAndFlipperRoutine, BALL_INTAKE_SET_POINT_TIMEOUT),
+                std::make_shared<IntakeBallUntilIn>(robot)
+//                std::make_shared<lib::WaitRoutine>(robot, 200l),
+//                std::make_shared<ElevatorAndFlipperRoutine>(robot, 0, FLIPPER_LOWER_ANGLE, "Reset")
+        };
+        AddSubRoutineRequirements();
     }
 }
\ No newline at end of file
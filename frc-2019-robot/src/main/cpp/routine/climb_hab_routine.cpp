@@ -3,7 +3,6 @@
 #include <robot.hpp>
 
 #include <routine/timed_drive_routine.hpp>
-#include <routine/set_elevator_position_routine.hpp>
 
 #include <lib/logger.hpp>
 #include <lib/parallel_routine.hpp>
@@ -11,7 +10,9 @@
 namespace garage {
     MainClimbRoutine::MainClimbRoutine(std::shared_ptr<Robot>& robot, double height)
             : Routine(robot, "Main Climb"), m_Height(height) {
-
+        AddRequirement(robot->GetSubsystem<Drive>());
+        AddRequirement(robot->GetSubsystem<Elevator>());
+        AddRequirement(robot->GetSubsystem<Outrigger>());
     }
 
     void MainClimbRoutine::Start() {
@@ -28,7 +29,7 @@ namespace garage {
         auto elevator = m_Robot->GetSubsystem<Elevator>();
         auto outrigger = m_Robot->GetSubsystem<Outrigger>();
         const double tilt = drive->GetTilt();
-        drive->LogSample(lib::Logger::LogLevel::k_Debug, lib::Logger::Format(" [%s] Tilt: %f", FMT_STR(m_Name), tilt));
+        drive->LogSample(lib::Logger::LogLevel::k_Debug, "[{}] Tilt: {}", m_Name, tilt);
         outrigger->SetRawOutput(tilt * OUTRIGGER_CLIMB_P + tilt * OUTRIGGER_CLIMB_F);
         if (elevator->GetPosition() < m_Height + ELEVATOR_WITHIN_SET_POINT_AMOUNT) {
             outrigger->SetWheelRawOutput(0.1);
@@ -47,16 +48,21 @@ namespace garage {
         return false;
     }
 
-    ClimbHabRoutine::ClimbHabRoutine(std::shared_ptr<Robot>& robot, double height) : SequentialRoutine(robot, "Climb Hab", {
-            std::make_shared<lib::ParallelRoutine>(robot, "Elevator and Outrigger initial Positions", lib::RoutineVector{
-                    std::make_shared<SetElevatorPositionRoutine>(robot, height + CLIMB_INITIAL_GAP_HEIGHT),
-                    std::make_shared<TimedDriveRoutine>(robot, 200l),
-                    std::make_shared<lib::WaitRoutine>(robot, 200l),
-                    std::make_shared<SetOutriggerAngleRoutine>(robot, 180.0)
-            }),
-            std::make_shared<MainClimbRoutine>(robot, height)
-    }) {
-
+    ClimbHabRoutine::ClimbHabRoutine(std::shared_ptr<Robot>& robot, double height)
+            : SequentialRoutine(robot, "Climb Hab", {}),
+              m_SetElevatorPositionRoutine(std::make_shared<SetElevatorPositionRoutine>(robot, height + CLIMB_INITIAL_GAP_HEIGHT)),
+              m_MainClimbRoutine(std::make_shared<MainClimbRoutine>(robot, height)) {
+        // Built here so the routines that depend on the height can be kept for rebinding
+        m_SubRoutines = {
+                std::make_shared<lib::ParallelRoutine>(robot, "Elevator and Outrigger initial Positions", lib::RoutineVector{
+                        m_SetElevatorPositionRoutine,
+                        std::make_shared<TimedDriveRoutine>(robot, 200l),
+                        std::make_shared<lib::WaitRoutine>(robot, 200l),
+                        std::make_shared<SetOutriggerAngleRoutine>(robot, 180.0)
+                }),
+                m_MainClimbRoutine
+        };
+        AddSubRoutineRequirements();
     }
 
     SetOutriggerAngleRoutine::SetOutriggerAngleRoutine(std::shared_ptr<Robot>& robot, double angle, const std::string& name)
@@ -8,21 +8,17 @@ namespace garage {
 
     void FlipOverRoutine::Start() {
         Routine::Start();
-        if (m_Subsystem) {
-            const double currentAngle = m_Subsystem->GetAngle();
-            m_TargetAngle = currentAngle < FLIPPER_STOW_ANGLE ? FLIPPER_UPPER_ANGLE : FLIPPER_LOWER_ANGLE;
-            m_Subsystem->SetAngle(m_TargetAngle);
-        }
+        const double currentAngle = m_Subsystem->GetAngle();
+        m_TargetAngle = currentAngle < FLIPPER_STOW_ANGLE ? FLIPPER_UPPER_ANGLE : FLIPPER_LOWER_ANGLE;
+        m_Subsystem->SetAngle(m_TargetAngle);
     }
 
     void FlipOverRoutine::Terminate() {
         Routine::Terminate();
-        if (m_Subsystem) {
-            m_Subsystem->Unlock();
-        }
+        m_Subsystem->Unlock();
     }
 
     bool FlipOverRoutine::CheckFinished() {
-        return m_Subsystem ? m_Subsystem->WithinAngle(m_TargetAngle) : true;
+        return m_Subsystem->WithinAngle(m_TargetAngle);
     }
 }
\ No newline at end of file
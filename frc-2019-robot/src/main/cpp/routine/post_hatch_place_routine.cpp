@@ -1,27 +1,26 @@
 #include <routine/post_hatch_place_routine.hpp>
 
-#include <routine/timed_drive_routine.hpp>
-
 #include <robot.hpp>
 
 namespace garage {
     PostHatchPlaceRoutine::PostHatchPlaceRoutine(std::shared_ptr<Robot> robot)
-            : SequentialRoutine(robot, "Post Hatch Placement Routine", {
-            std::make_shared<OpenHatchIntakeRoutine>(robot),
-            std::make_shared<lib::WaitRoutine>(robot, 600l, "Wait for Hatch Intake Routine"),
-            std::make_shared<TimedDriveRoutine>(robot, 800l, -0.08, "Back Out Routine")
-    }) {
-
+            : CoroutineRoutine(robot, "Post Hatch Placement Routine"),
+              m_Drive(robot->GetSubsystem<Drive>()), m_HatchIntake(robot->GetSubsystem<HatchIntake>()) {
+        AddRequirement(m_Drive);
+        AddRequirement(m_HatchIntake);
     }
 
-    OpenHatchIntakeRoutine::OpenHatchIntakeRoutine(std::shared_ptr<Robot> robot)
-            : Routine(robot, "Open Hatch Intake Routine") {
-
+    bool PostHatchPlaceRoutine::Run() {
+        ROUTINE_BEGIN();
+        m_HatchIntake->SetIntakeOpen(true);
+        ROUTINE_WAIT(POST_HATCH_PLACE_OPEN_TIME);
+        m_Drive->SetDriveOutput(POST_HATCH_PLACE_BACK_OUT_OUTPUT, POST_HATCH_PLACE_BACK_OUT_OUTPUT);
+        ROUTINE_WAIT(POST_HATCH_PLACE_BACK_OUT_TIME);
+        ROUTINE_END();
     }
 
-    void OpenHatchIntakeRoutine::Start() {
-        Routine::Start();
-        auto hatchIntake = m_Robot->GetSubsystem<HatchIntake>();
-        hatchIntake->SetIntakeOpen(true);
+    void PostHatchPlaceRoutine::Terminate() {
+        CoroutineRoutine::Terminate();
+        m_Drive->Unlock();
     }
-}
\ No newline at end of file
+}
@@ -10,15 +10,11 @@ namespace garage {
 
     void SoftLandElevatorRoutine::Start() {
         Routine::Start();
-        if (m_Subsystem) {
-            m_Subsystem->SoftLand();
-        }
+        m_Subsystem->SoftLand();
     }
 
     void SoftLandElevatorRoutine::Terminate() {
         Routine::Terminate();
-        if (m_Subsystem) {
-            m_Subsystem->Unlock();
-        }
+        m_Subsystem->Unlock();
     }
 }
\ No newline at end of file
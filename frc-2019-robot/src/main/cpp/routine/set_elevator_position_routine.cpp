@@ -5,26 +5,23 @@
 namespace garage {
     SetElevatorPositionRoutine::SetElevatorPositionRoutine(std::shared_ptr<Robot> robot, double setPoint, const std::string& name)
             : SubsystemRoutine(robot, name), m_SetPoint(setPoint) {
-        if (m_Subsystem) {
-            m_Subsystem->Log(lib::Logger::LogLevel::k_Debug, lib::Logger::Format("[%s] Set Elevator Set Point: %f", FMT_STR(name), setPoint));
-        }
+        lib::Logger::Log(lib::Logger::LogLevel::k_Debug, "[{}] Set Elevator Set Point: {}", name, setPoint);
     }
 
     void SetElevatorPositionRoutine::Start() {
         lib::Routine::Start();
-        if (m_Subsystem) {
-            m_Subsystem->SetWantedSetPoint(m_SetPoint);
-        }
+        m_Subsystem->SetWantedSetPoint(m_SetPoint);
     }
 
     void SetElevatorPositionRoutine::Terminate() {
         lib::Routine::Terminate();
-        if (m_Subsystem) {
-            m_Subsystem->Unlock();
-        }
+        m_Subsystem->Unlock();
     }
 
     bool SetElevatorPositionRoutine::CheckFinished() {
-        return m_Subsystem ? m_Subsystem->WithinPosition(m_SetPoint) : true;
+        if (m_Subsystem->WithinPosition(m_SetPoint)) return true;
+        // The elevator signals when it gets there
+        SleepUntilEvent(m_Subsystem->GetRequirement());
+        return false;
     }
 }
@@ -5,12 +5,10 @@
 namespace garage {
     void SetFlipperServoRoutine::Start() {
         Routine::Start();
-        if (m_Subsystem) {
-            if (m_ShouldLock) {
-                m_Subsystem->LockServo();
-            } else {
-                m_Subsystem->UnlockServo();
-            }
+        if (m_ShouldLock) {
+            m_Subsystem->LockServo();
+        } else {
+            m_Subsystem->UnlockServo();
         }
     }
 
@@ -5,26 +5,20 @@
 namespace garage {
     SetFlipperAngleRoutine::SetFlipperAngleRoutine(std::shared_ptr<Robot> robot, double angle, const std::string& name)
             : SubsystemRoutine(robot, name), m_Angle(angle) {
-        if (m_Subsystem) {
-            m_Subsystem->Log(lib::Logger::LogLevel::k_Info, lib::Logger::Format("[%s] Set Flipper Angle: %f", FMT_STR(name), angle));
-        }
+        lib::Logger::Log(lib::Logger::LogLevel::k_Info, "[{}] Set Flipper Angle: {}", name, angle);
     }
 
     void SetFlipperAngleRoutine::Start() {
         Routine::Start();
-        if (m_Subsystem) {
-            m_Subsystem->SetAngle(m_Angle);
-        }
+        m_Subsystem->SetAngle(m_Angle);
     }
 
     void SetFlipperAngleRoutine::Terminate() {
         Routine::Terminate();
-        if (m_Subsystem) {
-            m_Subsystem->Unlock();
-        }
+        m_Subsystem->Unlock();
     }
 
     bool SetFlipperAngleRoutine::CheckFinished() {
-        return m_Subsystem ? m_Subsystem->WithinAngle(m_Angle) : true;
+        return m_Subsystem->WithinAngle(m_Angle);
     }
 }
\ No newline at end of file
@@ -6,16 +6,14 @@
 
 namespace garage {
     BallIntake::BallIntake(std::shared_ptr<Robot>& robot) : Subsystem(robot, "Ball Intake") {
-        m_LeftIntake.ConfigFactoryDefault(CONFIG_TIMEOUT);
-        m_RightIntake.ConfigFactoryDefault(CONFIG_TIMEOUT);
-        m_LeftIntake.SetNeutralMode(ctre::phoenix::motorcontrol::NeutralMode::Brake);
-        m_RightIntake.SetNeutralMode(ctre::phoenix::motorcontrol::NeutralMode::Brake);
-        m_LeftIntake.ConfigVoltageCompSaturation(DEFAULT_VOLTAGE_COMPENSATION, CONFIG_TIMEOUT);
-        m_RightIntake.ConfigVoltageCompSaturation(DEFAULT_VOLTAGE_COMPENSATION, CONFIG_TIMEOUT);
-        m_LeftIntake.EnableVoltageCompensation(true);
-        m_RightIntake.EnableVoltageCompensation(true);
-        m_RightIntake.Set(ctre::phoenix::motorcontrol::ControlMode::PercentOutput, 0);
-        m_LeftIntake.Set(ctre::phoenix::motorcontrol::ControlMode::PercentOutput, 0);
+        m_LeftIntake.RestoreFactoryDefaults();
+        m_RightIntake.RestoreFactoryDefaults();
+        m_LeftIntake.SetBrakeMode(true);
+        m_RightIntake.SetBrakeMode(true);
+        m_LeftIntake.EnableVoltageCompensation(DEFAULT_VOLTAGE_COMPENSATION);
+        m_RightIntake.EnableVoltageCompensation(DEFAULT_VOLTAGE_COMPENSATION);
+        m_RightIntake.Set(0.0);
+        m_LeftIntake.Set(0.0);
         SetOutput(0.0);
         ConfigOpenLoopRamp(0.15);
     }
@@ -25,11 +23,11 @@ namespace garage {
         SetOutput(0.0);
     }
 
-    bool BallIntake::ShouldUnlock(Command& command) {
+    bool BallIntake::ShouldUnlock(const Command& command) {
         return std::fabs(command.ballIntake) > DEFAULT_INPUT_THRESHOLD;
     }
 
-    void BallIntake::UpdateUnlocked(Command& command) {
+    void BallIntake::UpdateUnlocked(const Command& command) {
         double input = command.ballIntake, absoluteInput = std::fabs(input);
         if (absoluteInput > 0.5) input = math::sign(input) * 1.0;
         if (input > 0.0) {
@@ -41,35 +39,40 @@ namespace garage {
         }
     }
 
-    void BallIntake::SpacedUpdate(Command& command) {
-        const double outputCurrent = m_RightIntake.GetOutputCurrent();
-        m_NetworkTable->PutNumber("Current", outputCurrent);
-        if (outputCurrent > HAS_BALL_STALL_CURRENT) {
+    void BallIntake::SpacedUpdate(const Command& command) {
+        m_Current = m_RightIntake.GetOutputCurrent();
+        m_NetworkTable->PutNumber("Current", m_Current);
+        if (m_Current > HAS_BALL_STALL_CURRENT) {
             m_HasBallCount++;
         } else if (m_HasBallCount > 0) {
             m_HasBallCount = 0;
         }
     }
 
+    void BallIntake::FillTelemetry(lib::SubsystemTelemetry& telemetry) {
+        telemetry.output = static_cast<float>(m_LastOutput);
+        telemetry.current = static_cast<float>(m_Current);
+    }
+
     bool BallIntake::HasBall() {
         return m_HasBallCount > HAS_BALL_COUNTS_REQUIRED;
     }
 
     void BallIntake::SetOutput(double output) {
         if (m_Robot->ShouldOutput()) {
-            m_RightIntake.Set(ctre::phoenix::motorcontrol::ControlMode::PercentOutput, output);
-            m_LeftIntake.Set(ctre::phoenix::motorcontrol::ControlMode::PercentOutput, output);
+            m_RightIntake.Set(output);
+            m_LeftIntake.Set(output);
             m_LastOutput = output;
         }
     }
 
     void BallIntake::ConfigOpenLoopRamp(double ramp) {
         if (m_LastOpenLoopRamp != ramp) {
-            auto leftError = m_LeftIntake.ConfigOpenloopRamp(ramp), rightError = m_RightIntake.ConfigOpenloopRamp(ramp);
-            if (leftError == ctre::phoenix::OK && rightError == ctre::phoenix::OK) {
+            const bool isLeftOk = m_LeftIntake.SetOpenLoopRampRate(ramp), isRightOk = m_RightIntake.SetOpenLoopRampRate(ramp);
+            if (isLeftOk && isRightOk) {
                 m_LastOpenLoopRamp = ramp;
             } else {
-                Log(lib::Logger::LogLevel::k_Error, lib::Logger::Format("Left Error: %d, Right Error: %d", leftError, rightError));
+                Log(lib::Logger::LogLevel::k_Error, "Failed setting ramp, left okay: {}, right okay: {}", isLeftOk, isRightOk);
             }
         }
     }
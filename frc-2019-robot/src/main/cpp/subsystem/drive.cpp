@@ -7,7 +7,7 @@
 #include <cmath>
 
 namespace garage {
-    Drive::Drive(std::shared_ptr<Robot>& robot) : ControllableSubsystem(robot, "Drive") {
+    Drive::Drive(std::shared_ptr<Robot>& robot) : StaticControllableSubsystem(robot, "Drive") {
         m_LeftSlave.RestoreFactoryDefaults();
         m_RightSlave.RestoreFactoryDefaults();
         m_LeftMaster.RestoreFactoryDefaults();
@@ -20,8 +20,8 @@ namespace garage {
         m_LeftMaster.SetOpenLoopRampRate(DRIVE_RAMPING);
         m_RightMaster.SetOpenLoopRampRate(DRIVE_RAMPING);
         // Input dead band
-        m_LeftMaster.SetParameter(rev::CANSparkMax::ConfigParameter::kInputDeadband, DRIVE_INPUT_DEAD_BAND);
-        m_RightMaster.SetParameter(rev::CANSparkMax::ConfigParameter::kInputDeadband, DRIVE_INPUT_DEAD_BAND);
+        m_LeftMaster.SetInputDeadband(DRIVE_INPUT_DEAD_BAND);
+        m_RightMaster.SetInputDeadband(DRIVE_INPUT_DEAD_BAND);
         // Voltage compensation
         m_LeftMaster.EnableVoltageCompensation(DEFAULT_VOLTAGE_COMPENSATION);
         m_RightMaster.EnableVoltageCompensation(DEFAULT_VOLTAGE_COMPENSATION);
@@ -29,15 +29,12 @@ namespace garage {
     }
 
     void Drive::OnPostInitialize() {
-        auto drive = WeakFromThis();
-        AddController(m_RawController = std::make_shared<RawDriveController>(drive));
-        AddController(m_ManualController = std::make_shared<ManualDriveController>(drive));
-        AddController(m_AutoAlignController = std::make_shared<AutoAlignDriveController>(drive));
-        SetUnlockedController(m_ManualController);
+        CreateControllers();
+        SetUnlockedController<ManualDriveController>();
     }
 
     void Drive::Reset() {
-        ControllableSubsystem::Reset();
+        StaticControllableSubsystem::Reset();
         StopMotors();
     }
 
@@ -48,17 +45,19 @@ namespace garage {
         m_RightMaster.Set(0.0);
     }
 
-    bool Drive::ShouldUnlock(Command& command) {
+    bool Drive::ShouldUnlock(const Command& command) {
         return std::fabs(command.driveForward) > DEFAULT_INPUT_THRESHOLD ||
                std::fabs(command.driveTurn) > DEFAULT_INPUT_THRESHOLD;
     }
 
-    void Drive::SpacedUpdate(Command& command) {
+    void Drive::SpacedUpdate(const Command& command) {
         const double
                 leftOutput = m_LeftMaster.GetAppliedOutput(),
                 rightOutput = m_RightMaster.GetAppliedOutput(),
                 leftCurrent = m_LeftMaster.GetOutputCurrent(),
                 rightCurrent = m_RightMaster.GetOutputCurrent();
+        m_AppliedOutput = (leftOutput + rightOutput) * 0.5;
+        m_Current = leftCurrent + rightCurrent;
 //        const double heading = m_Pigeon.GetFusedHeading(), fixedHeading = math::fixAngle(heading);
         const double heading = 0.0, fixedHeading = 0.0;
         m_NetworkTable->PutNumber("Gyro", fixedHeading);
@@ -73,14 +72,17 @@ namespace garage {
 //                leftOutput, rightOutput, leftCurrent, rightCurrent));
     }
 
+    void Drive::FillTelemetry(lib::SubsystemTelemetry& telemetry) {
+        // One entry per subsystem, so record the average of both sides and the total current
+        telemetry.position = static_cast<float>((m_LeftEncoderPosition + m_RightEncoderPosition) * 0.5);
+        telemetry.output = static_cast<float>(m_AppliedOutput);
+        telemetry.current = static_cast<float>(m_Current);
+    }
+
     void Drive::Update() {
         m_RightEncoderPosition = m_RightEncoder.GetPosition();
         m_LeftEncoderPosition = m_LeftEncoder.GetPosition();
-        if (m_Controller) {
-            m_Controller->Control();
-        } else {
-            LogSample(lib::Logger::LogLevel::k_Warning, "No controller detected");
-        }
+        RunController();
         if (m_Robot->ShouldOutput()) {
             m_LeftMaster.Set(m_LeftOutput);
             m_RightMaster.Set(m_RightOutput);
@@ -99,8 +101,8 @@ namespace garage {
     }
 
     void Drive::SetDriveOutput(double left, double right) {
-        SetController(m_RawController);
-        m_RawController->SetDriveOutput(left, right);
+        SetController<RawDriveController>();
+        GetController<RawDriveController>().SetDriveOutput(left, right);
     }
 
     double Drive::GetTilt() {
@@ -118,7 +120,7 @@ namespace garage {
     }
 
     void Drive::AutoAlign() {
-        SetController(m_AutoAlignController);
+        SetController<AutoAlignDriveController>();
     }
 
     void RawDriveController::Reset() {
@@ -127,9 +129,9 @@ namespace garage {
     }
 
     void RawDriveController::Control() {
-        auto drive = m_Subsystem.lock();
-        drive->m_LeftOutput = m_LeftOutput;
-        drive->m_RightOutput = m_RightOutput;
+        Drive& drive = m_Subsystem;
+        drive.m_LeftOutput = m_LeftOutput;
+        drive.m_RightOutput = m_RightOutput;
     }
 
     void ManualDriveController::Reset() {
@@ -141,14 +143,14 @@ namespace garage {
         m_IsQuickTurn = false;
     }
 
-    void ManualDriveController::ProcessCommand(Command& command) {
+    void ManualDriveController::ProcessCommand(const Command& command) {
         m_ForwardInput = command.driveForward * 0.5;
         m_TurnInput = command.driveTurn * 0.19;
         m_IsQuickTurn = command.isQuickTurn;
     }
 
     void ManualDriveController::Control() {
-        auto drive = m_Subsystem.lock();
+        Drive& drive = m_Subsystem;
 //        double turnInput = m_TurnInput, forwardInput = m_ForwardInput;
 //        const double negativeInertia = turnInput - m_OldTurnInput;
 //        m_OldTurnInput = turnInput;
@@ -215,33 +217,33 @@ namespace garage {
 //            leftOutput += overPower * (-1.0 - rightOutput);
 //            rightOutput = -1.0;
 //        }
-//        drive->m_LeftOutput = leftOutput;
-//        drive->m_RightOutput = rightOutput;
-        drive->m_LeftOutput = m_ForwardInput + m_TurnInput;
-        drive->m_RightOutput = m_ForwardInput - m_TurnInput;
+//        drive.m_LeftOutput = leftOutput;
+//        drive.m_RightOutput = rightOutput;
+        drive.m_LeftOutput = m_ForwardInput + m_TurnInput;
+        drive.m_RightOutput = m_ForwardInput - m_TurnInput;
     }
 
-    AutoAlignDriveController::AutoAlignDriveController(std::weak_ptr<Drive>& subsystem)
-            : SubsystemController(subsystem, "Auto Align Drive Controller"), m_Limelight(subsystem.lock()->m_Robot->GetLimelight()) {
+    AutoAlignDriveController::AutoAlignDriveController(Drive& subsystem)
+            : SubsystemController(subsystem, "Auto Align Drive Controller"), m_Limelight(subsystem.m_Robot->GetLimelight()) {
     }
 
     void AutoAlignDriveController::Control() {
-        auto drive = m_Subsystem.lock();
+        Drive& drive = m_Subsystem;
         if (m_Limelight.HasTarget()) {
             const double
                     tx = m_Limelight.GetHorizontalAngleToTarget(),
                     ta = m_Limelight.GetTargetPercentArea(),
                     ts = m_Limelight.GetSkew();
-//            drive->LogSample(lib::Logger::LogLevel::k_Info, lib::Logger::Format("TX: %f, TA: %f TS: %f", tx, ta, ts));
+//            drive.LogSample(lib::Logger::LogLevel::k_Info, lib::Logger::Format("TX: %f, TA: %f TS: %f", tx, ta, ts));
             double thresholdTx = (std::fabs(tx) - 3.0) > 1.5 ? tx : 0.0;
             const double turnOutput = math::clamp(thresholdTx * VISION_TURN_P, -VISION_MAX_TURN, VISION_MAX_TURN),
                     delta = VISION_DESIRED_TARGET_AREA - ta,
                     thresholdDelta = std::fabs(delta) > VISION_AREA_THRESHOLD ? delta : 0.0,
                     forwardOutput = math::clamp(thresholdDelta * VISION_FORWARD_P, -VISION_MAX_FORWARD, VISION_MAX_FORWARD);
-            drive->m_LeftOutput = forwardOutput + turnOutput;
-            drive->m_RightOutput = forwardOutput - turnOutput;
+            drive.m_LeftOutput = forwardOutput + turnOutput;
+            drive.m_RightOutput = forwardOutput - turnOutput;
         } else {
-            drive->Unlock();
+            drive.Unlock();
         }
     }
 }
@@ -12,24 +12,24 @@ namespace garage {
 //
 //    };
 
-    Flipper::Flipper(std::shared_ptr<Robot>& robot) : ControllableSubsystem(robot, "Flipper") {
+    Flipper::Flipper(std::shared_ptr<Robot>& robot) : StaticControllableSubsystem(robot, "Flipper") {
         m_FlipperMaster.RestoreFactoryDefaults();
-        m_FlipperMaster.SetIdleMode(rev::CANSparkMax::IdleMode::kBrake);
+        m_FlipperMaster.SetBrakeMode(true);
         m_FlipperMaster.SetClosedLoopRampRate(FLIPPER_CLOSED_LOOP_RAMP);
-        m_FlipperController.SetP(FLIPPER_P, FLIPPER_SMART_MOTION_PID_SLOT);
-        m_FlipperController.SetI(FLIPPER_I, FLIPPER_SMART_MOTION_PID_SLOT);
-        m_FlipperController.SetD(FLIPPER_D, FLIPPER_SMART_MOTION_PID_SLOT);
-        m_FlipperController.SetIZone(FLIPPER_I_ZONE, FLIPPER_SMART_MOTION_PID_SLOT);
-        m_FlipperController.SetIMaxAccum(FLIPPER_MAX_ACCUM, FLIPPER_SMART_MOTION_PID_SLOT);
-        m_FlipperController.SetFF(FLIPPER_FF, FLIPPER_SMART_MOTION_PID_SLOT);
-        m_FlipperController.SetOutputRange(-1.0, 1.0, FLIPPER_SMART_MOTION_PID_SLOT);
-        m_FlipperController.SetSmartMotionMaxVelocity(FLIPPER_VELOCITY, FLIPPER_SMART_MOTION_PID_SLOT);
-        m_FlipperController.SetSmartMotionMinOutputVelocity(0.0, FLIPPER_SMART_MOTION_PID_SLOT);
-        m_FlipperController.SetSmartMotionMaxAccel(FLIPPER_ACCELERATION, FLIPPER_SMART_MOTION_PID_SLOT);
-        m_FlipperController.SetSmartMotionAllowedClosedLoopError(FLIPPER_ALLOWABLE_ERROR, FLIPPER_SMART_MOTION_PID_SLOT);
-        m_FlipperMaster.SetParameter(rev::CANSparkMax::ConfigParameter::kInputDeadband, 0.02);
+        m_FlipperMaster.SetP(FLIPPER_P, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetI(FLIPPER_I, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetD(FLIPPER_D, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetIZone(FLIPPER_I_ZONE, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetIMaxAccum(FLIPPER_MAX_ACCUM, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetFF(FLIPPER_FF, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetOutputRange(-1.0, 1.0, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetSmartMotionMaxVelocity(FLIPPER_VELOCITY, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetSmartMotionMinOutputVelocity(0.0, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetSmartMotionMaxAccel(FLIPPER_ACCELERATION, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetSmartMotionAllowedClosedLoopError(FLIPPER_ALLOWABLE_ERROR, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetInputDeadband(0.02);
         // TODO yay or nay with s-curve?
-        m_FlipperController.SetSmartMotionAccelStrategy(rev::CANPIDController::AccelStrategy::kSCurve, FLIPPER_SMART_MOTION_PID_SLOT);
+        m_FlipperMaster.SetSmartMotionAccelStrategy(lib::AccelStrategy::k_SCurve, FLIPPER_SMART_MOTION_PID_SLOT);
         m_FlipperMaster.EnableVoltageCompensation(DEFAULT_VOLTAGE_COMPENSATION);
         m_ReverseLimitSwitch.EnableLimitSwitch(true);
         m_ForwardLimitSwitch.EnableLimitSwitch(true);
@@ -37,11 +37,8 @@ namespace garage {
     }
 
     void Flipper::OnPostInitialize() {
-        auto flipper = WeakFromThis();
-        AddController(m_RawController = std::make_shared<RawFlipperController>(flipper));
-        AddController(m_SetPointController = std::make_shared<SetPointFlipperController>(flipper));
-        AddController(m_VelocityController = std::make_shared<VelocityFlipperController>(flipper));
-        SetUnlockedController(m_VelocityController);
+        CreateControllers();
+        SetUnlockedController<VelocityFlipperController>();
 //        SetupNetworkTableValues();
     }
 
@@ -51,33 +48,27 @@ namespace garage {
             return true;
         });
         AddNetworkTableListener("P", FLIPPER_P, [this](const double p) {
-            auto error = m_FlipperController.SetP(p, FLIPPER_SMART_MOTION_PID_SLOT);
-            return error == rev::CANError::kOK;
+            return m_FlipperMaster.SetP(p, FLIPPER_SMART_MOTION_PID_SLOT);
         });
         AddNetworkTableListener("I", FLIPPER_I, [this](const double i) {
-            auto error = m_FlipperController.SetI(i, FLIPPER_SMART_MOTION_PID_SLOT);
-            return error == rev::CANError::kOK;
+            return m_FlipperMaster.SetI(i, FLIPPER_SMART_MOTION_PID_SLOT);
         });
         AddNetworkTableListener("I Zone", FLIPPER_I_ZONE, [this](const double iZone) {
-            auto error = m_FlipperController.SetIZone(iZone, FLIPPER_SMART_MOTION_PID_SLOT);
-            return error == rev::CANError::kOK;
+            return m_FlipperMaster.SetIZone(iZone, FLIPPER_SMART_MOTION_PID_SLOT);
         });
         AddNetworkTableListener("Max Accum", FLIPPER_MAX_ACCUM, [this](const double maxAccum) {
-            auto error = m_FlipperController.SetIMaxAccum(maxAccum, FLIPPER_SMART_MOTION_PID_SLOT);
-            return error == rev::CANError::kOK;
+            return m_FlipperMaster.SetIMaxAccum(maxAccum, FLIPPER_SMART_MOTION_PID_SLOT);
         });
         AddNetworkTableListener("D", FLIPPER_D, [this](const double d) {
-            auto error = m_FlipperController.SetD(d, FLIPPER_SMART_MOTION_PID_SLOT);
-            return error == rev::CANError::kOK;
+            return m_FlipperMaster.SetD(d, FLIPPER_SMART_MOTION_PID_SLOT);
         });
         AddNetworkTableListener("FF", FLIPPER_FF, [this](const double ff) {
-            auto error = m_FlipperController.SetFF(ff, FLIPPER_SMART_MOTION_PID_SLOT);
-            return error == rev::CANError::kOK;
+            return m_FlipperMaster.SetFF(ff, FLIPPER_SMART_MOTION_PID_SLOT);
         });
     }
 
     void Flipper::Reset() {
-        ControllableSubsystem::Reset();
+        StaticControllableSubsystem::Reset();
         m_FirstForwardLimitSwitchHit = true;
         m_FirstReverseLimitSwitchHit = true;
         m_IsForwardLimitSwitchDown = false;
@@ -85,20 +76,26 @@ namespace garage {
         m_LockServoOutput = LOCK_SERVO_LOWER;
     }
 
-    bool Flipper::ShouldUnlock(Command& command) {
+    void Flipper::FillTelemetry(lib::SubsystemTelemetry& telemetry) {
+        telemetry.position = static_cast<float>(m_EncoderPosition);
+        telemetry.velocity = static_cast<float>(m_EncoderVelocity);
+        telemetry.output = static_cast<float>(m_Output);
+        telemetry.current = static_cast<float>(m_Current);
+    }
+
+    bool Flipper::ShouldUnlock(const Command& command) {
         return std::fabs(command.flipper) > DEFAULT_INPUT_THRESHOLD && m_LockServoOutput != LOCK_SERVO_UPPER;
     }
 
-    void Flipper::HandleLimitSwitch(rev::CANDigitalInput& limitSwitch, bool& isLimitSwitchDown, bool& isFirstHit, double resetEncoderValue) {
+    void Flipper::HandleLimitSwitch(lib::LimitSwitch& limitSwitch, bool& isLimitSwitchDown, bool& isFirstHit, double resetEncoderValue) {
         isLimitSwitchDown = limitSwitch.Get();
         if (isLimitSwitchDown) {
             if (isFirstHit) {
-                auto error = m_Encoder.SetPosition(resetEncoderValue);
-                if (error == rev::CANError::kOK) {
-                    Log(lib::Logger::LogLevel::k_Info, lib::Logger::Format("Limit switch hit and encoder reset to %f", resetEncoderValue));
+                if (m_Encoder.SetPosition(resetEncoderValue)) {
+                    Log(lib::Logger::LogLevel::k_Info, "Limit switch hit and encoder reset to {}", resetEncoderValue);
                     isFirstHit = false;
                 } else {
-                    Log(lib::Logger::LogLevel::k_Error, lib::Logger::Format("CAN Error: %d", error));
+                    Log(lib::Logger::LogLevel::k_Error, "Failed resetting encoder to {}", resetEncoderValue);
                 }
             }
         } else {
@@ -118,7 +115,7 @@ namespace garage {
         faults &= ~(1 << 14);
         faults &= ~(1 << 15);
         if (faults) {
-            Log(lib::Logger::LogLevel::k_Error, lib::Logger::Format("Sticky Fault Error: %d", faults));
+            Log(lib::Logger::LogLevel::k_Error, "Sticky Fault Error: {}", faults);
             m_FlipperMaster.ClearFaults();
         }
         int cameraServoOutput;
@@ -137,23 +134,20 @@ namespace garage {
         m_CameraServoOutput = static_cast<uint16_t>(cameraServoOutput);
         m_CameraServo.SetRaw(m_CameraServoOutput);
 //        m_LockServo.SetRaw(m_LockServoOutput);
-        if (m_Controller) {
-            m_Controller->Control();
-        } else {
-            LogSample(lib::Logger::LogLevel::k_Warning, "No controller detected");
-        }
+        RunController();
     }
 
-    void Flipper::SpacedUpdate(Command& command) {
-        const double appliedOutput = m_FlipperMaster.GetAppliedOutput(), current = m_FlipperMaster.GetOutputCurrent();
+    void Flipper::SpacedUpdate(const Command& command) {
+        m_Output = m_FlipperMaster.GetAppliedOutput();
+        m_Current = m_FlipperMaster.GetOutputCurrent();
         m_NetworkTable->PutNumber("Angle", m_Angle);
         m_NetworkTable->PutNumber("Position", m_EncoderPosition);
         m_NetworkTable->PutNumber("Velocity", m_EncoderVelocity);
-        m_NetworkTable->PutNumber("Output", appliedOutput);
-        m_NetworkTable->PutNumber("Current", appliedOutput);
+        m_NetworkTable->PutNumber("Output", m_Output);
+        m_NetworkTable->PutNumber("Current", m_Current);
 //        Log(lib::Logger::LogLevel::k_Info, lib::Logger::Format(
 //                "Output: %f, Current: %f, Angle: %f, Encoder Position: %f, Encoder Velocity: %f, Reverse Limit Switch: %s, Forward Limit Switch: %s",
-//                appliedOutput, current,
+//                m_Output, m_Current,
 //                m_Angle, m_EncoderPosition, m_EncoderVelocity,
 //                m_IsReverseLimitSwitchDown ? "true" : "false", m_IsForwardLimitSwitchDown ? "true" : "false"));
     }
@@ -170,13 +164,13 @@ namespace garage {
     }
 
     void Flipper::SetRawOutput(double output) {
-        SetController(m_RawController);
-        m_RawController->SetOutput(output);
+        SetController<RawFlipperController>();
+        GetController<RawFlipperController>().SetOutput(output);
     }
 
     void Flipper::SetSetPoint(double setPoint) {
-        SetController(m_SetPointController);
-        m_SetPointController->SetSetPoint(setPoint);
+        SetController<SetPointFlipperController>();
+        GetController<SetPointFlipperController>().SetSetPoint(setPoint);
     }
 
     void Flipper::SetAngle(double angle) {
@@ -213,9 +207,9 @@ namespace garage {
     }
 
     double Flipper::GetWantedAngle() {
-        // TODO fix architecture
-        auto controller = std::dynamic_pointer_cast<FlipperController>(m_Controller);
-        return controller ? controller->GetWantedAngle() : GetAngle();
+        double wantedAngle = GetAngle();
+        VisitController(m_ControllerIndex, [&wantedAngle](FlipperController& controller) { wantedAngle = controller.GetWantedAngle(); });
+        return wantedAngle;
     }
 
     /* =============================================================== Controllers ===============================================================
@@ -223,18 +217,18 @@ namespace garage {
        =========================================================================================================================================== */
 
     double FlipperController::GetWantedAngle() {
-        return m_Subsystem.lock()->GetAngle();
+        return m_Subsystem.GetAngle();
     }
 
-    void RawFlipperController::ProcessCommand(Command& command) {
+    void RawFlipperController::ProcessCommand(const Command& command) {
         m_Output = command.flipper * FLIPPER_RAW_POWER;
     }
 
     void RawFlipperController::Control() {
-        auto flipper = m_Subsystem.lock();
+        Flipper& flipper = m_Subsystem;
 //        Log(lib::Logger::LogLevel::k_Debug, lib::Logger::Format("Wanted Output: %f", m_Output));
-        if (flipper->m_Robot->ShouldOutput()) {
-            flipper->m_FlipperMaster.Set(m_Output);
+        if (flipper.m_Robot->ShouldOutput()) {
+            flipper.m_FlipperMaster.Set(m_Output);
         }
     }
 
@@ -242,61 +236,61 @@ namespace garage {
         m_Output = output;
     }
 
-    void VelocityFlipperController::ProcessCommand(Command& command) {
-        auto flipper = m_Subsystem.lock();
-        m_WantedVelocity = command.flipper * flipper->m_MaxVelocity * FLIPPER_MANUAL_POWER;
+    void VelocityFlipperController::ProcessCommand(const Command& command) {
+        Flipper& flipper = m_Subsystem;
+        m_WantedVelocity = command.flipper * flipper.m_MaxVelocity * FLIPPER_MANUAL_POWER;
     }
 
     void VelocityFlipperController::Control() {
-        auto flipper = m_Subsystem.lock();
-        if (flipper->IsWithinMotorOutputConditions(m_WantedVelocity, 0.0, 0.0)) {
+        Flipper& flipper = m_Subsystem;
+        if (flipper.IsWithinMotorOutputConditions(m_WantedVelocity, 0.0, 0.0)) {
             const double
-                    angleFeedForward = std::cos(math::d2r(flipper->m_Angle + FLIPPER_COM_ANGLE_FF_OFFSET)) * flipper->m_AngleFeedForward,
+                    angleFeedForward = std::cos(math::d2r(flipper.m_Angle + FLIPPER_COM_ANGLE_FF_OFFSET)) * flipper.m_AngleFeedForward,
                     feedForward = angleFeedForward;
-            if (flipper->m_Robot->ShouldOutput()) {
-                auto error = flipper->m_FlipperController.SetReference(m_WantedVelocity, rev::ControlType::kSmartVelocity,
+            if (flipper.m_Robot->ShouldOutput()) {
+                const bool isOk = flipper.m_FlipperMaster.SetReference(m_WantedVelocity, lib::ControlType::k_SmartVelocity,
                                                                        FLIPPER_SMART_MOTION_PID_SLOT, feedForward * DEFAULT_VOLTAGE_COMPENSATION);
-                if (error == rev::CANError::kOK) {
-//                    flipper->LogSample(lib::Logger::LogLevel::k_Debug,
-//                                       lib::Logger::Format("Wanted Velocity: %f, Output Feed Forward: %f, Feed Forward: %f",
-//                                                           m_WantedVelocity, angleFeedForward, flipper->m_AngleFeedForward));
+                if (isOk) {
+//                    flipper.LogSample(lib::Logger::LogLevel::k_Debug,
+//                                      lib::Logger::Format("Wanted Velocity: %f, Output Feed Forward: %f, Feed Forward: %f",
+//                                                          m_WantedVelocity, angleFeedForward, flipper.m_AngleFeedForward));
                 } else {
-                    Log(lib::Logger::LogLevel::k_Error, lib::Logger::Format("CAN Error: %d", error));
+                    Log(lib::Logger::LogLevel::k_Error, "CAN error setting reference");
                 }
             }
         } else {
-            flipper->LogSample(lib::Logger::LogLevel::k_Debug, "Not doing anything");
-            flipper->m_FlipperMaster.Set(0.0);
+            flipper.LogSample(lib::Logger::LogLevel::k_Debug, "Not doing anything");
+            flipper.m_FlipperMaster.Set(0.0);
         }
     }
 
-    void SetPointFlipperController::ProcessCommand(garage::Command& command) {
+    void SetPointFlipperController::ProcessCommand(const garage::Command& command) {
         m_SetPoint = math::clamp(m_SetPoint + command.flipper, FLIPPER_LOWER, FLIPPER_UPPER);
     }
 
     void SetPointFlipperController::Control() {
-        auto flipper = m_Subsystem.lock();
-        if (flipper->IsWithinMotorOutputConditions(m_SetPoint, FLIPPER_SET_POINT_LOWER, FLIPPER_SET_POINT_UPPER)) {
+        Flipper& flipper = m_Subsystem;
+        if (flipper.IsWithinMotorOutputConditions(m_SetPoint, FLIPPER_SET_POINT_LOWER, FLIPPER_SET_POINT_UPPER)) {
             const double
                     clampedSetPoint = math::clamp(m_SetPoint, FLIPPER_SET_POINT_LOWER, FLIPPER_SET_POINT_UPPER),
-                    angleFeedForward = std::cos(math::d2r(flipper->m_Angle + FLIPPER_COM_ANGLE_FF_OFFSET)) * flipper->m_AngleFeedForward,
+                    angleFeedForward = std::cos(math::d2r(flipper.m_Angle + FLIPPER_COM_ANGLE_FF_OFFSET)) * flipper.m_AngleFeedForward,
                     feedForward = angleFeedForward;
-            if (flipper->m_Robot->ShouldOutput()) {
-                auto error = flipper->m_FlipperController.SetReference(m_SetPoint, rev::ControlType::kSmartMotion,
+            if (flipper.m_Robot->ShouldOutput()) {
+                const bool isOk = flipper.m_FlipperMaster.SetReference(m_SetPoint, lib::ControlType::k_SmartMotion,
                                                                        FLIPPER_SMART_MOTION_PID_SLOT, feedForward * DEFAULT_VOLTAGE_COMPENSATION);
-                if (error == rev::CANError::kOK) {
+                if (isOk) {
 //                    Log(lib::Logger::LogLevel::k_Debug, lib::Logger::Format("Wanted set point: %f", m_SetPoint));
                 } else {
-                    Log(lib::Logger::LogLevel::k_Error, lib::Logger::Format("CAN Error: %d", error));
+                    Log(lib::Logger::LogLevel::k_Error, "CAN error setting reference");
                 }
             }
         } else {
-//            flipper->LogSample(lib::Logger::LogLevel::k_Debug, lib::Logger::Format("Not doing anything, wanted set point: %f", m_SetPoint));
-            flipper->m_FlipperMaster.Set(0.0);
+//            flipper.LogSample(lib::Logger::LogLevel::k_Debug, lib::Logger::Format("Not doing anything, wanted set point: %f", m_SetPoint));
+            flipper.m_FlipperMaster.Set(0.0);
         }
     }
 
     double SetPointFlipperController::GetWantedAngle() {
-        return m_Subsystem.lock()->RawSetPointToAngle(m_SetPoint);
+        return m_Subsystem.RawSetPointToAngle(m_SetPoint);
     }
 }
@@ -9,7 +9,7 @@ namespace garage {
 
     }
 
-    bool HatchIntake::ShouldUnlock(Command& command) {
+    bool HatchIntake::ShouldUnlock(const Command& command) {
         return command.hatchIntakeDown;
     }
 
@@ -19,7 +19,7 @@ namespace garage {
         m_ServoOutput = HATCH_SERVO_UPPER;
     }
 
-    void HatchIntake::UpdateUnlocked(Command& command) {
+    void HatchIntake::UpdateUnlocked(const Command& command) {
         if (command.hatchIntakeDown) {
             m_IntakeOpen = !m_IntakeOpen;
         }
@@ -35,6 +35,11 @@ namespace garage {
         m_Servo.SetRaw(m_ServoOutput);
     }
 
+    void HatchIntake::FillTelemetry(lib::SubsystemTelemetry& telemetry) {
+        telemetry.position = m_IntakeOpen ? 1.0f : 0.0f;
+        telemetry.output = m_ServoOutput;
+    }
+
     void HatchIntake::SetIntakeOpen(bool isOpen) {
         m_IntakeOpen = isOpen;
     }
@@ -1,15 +1,39 @@
 #pragma once
 
-#include <lib/routine.hpp>
-
 #include <vector>
-#include <memory>
+#include <cstdint>
+#include <type_traits>
 
 namespace garage {
+    /**
+     * Everything the drivers asked for in one loop. Robot::UpdateCommand only reads the controllers into it and
+     * Robot::ExecuteCommand acts on it, so a recorded stream of these replays a match. It is plain data so the robot
+     * can keep this loop's and the last loop's side by side and hand them out by reference.
+     */
     struct Command {
     public:
         double driveForward, driveTurn, flipper, ballIntake, elevatorInput, outrigger, outriggerWheel;
         bool hatchIntakeDown, offTheBooksModeEnabled, isQuickTurn;
-        std::vector<std::shared_ptr<lib::Routine>> routines;
+        // ==== Buttons that act right away instead of through a subsystem controller
+        bool terminateRoutines, autoAlign, autoAlignPressed, autoAlignReleased;
+        bool hasElevatorSetPoint, hasFlipperAngle;
+        double elevatorSetPoint, flipperAngle;
     };
+
+    static_assert(std::is_trivially_copyable<Command>::value, "Commands are copied as plain data");
+
+    /**
+     * Routines the drivers can ask for. Each one is built once, and ones that only differ by their parameters share a
+     * routine that is rebound when asked for, see Robot::GetCommandRoutine. The command log records these values,
+     * so only ever append.
+     */
+    enum class CommandRoutine : uint8_t {
+        k_ResetWithServo, k_GroundBallIntake, k_LoadingBallIntake, k_PostHatchPlacement,
+        k_EndGame, k_SecondLevelClimb, k_ThirdLevelClimb, k_StowFlipper
+    };
+
+    /**
+     * Routines the drivers asked to start in one loop, kept apart from the command since their number varies
+     */
+    using RoutineRequests=std::vector<CommandRoutine>;
 }
@@ -32,7 +32,7 @@ namespace garage {
             int m_TrajectorySize;
             std::vector<Segment> m_LeftTrajectory, m_RightTrajectory;
             EncoderConfig m_LeftEncoderConfig, m_RightEncoderConfig;
-            EncoderFollower m_LeftFollower, m_RightFollower;
+            EncoderFollower m_LeftFollower{}, m_RightFollower{};
 
             virtual void GetWaypoints() {}
 
@@ -52,6 +52,13 @@ namespace garage {
             void Terminate() override;
 
             void PostInitialize() override;
+
+            /**
+             * True once both followers have run through every segment
+             */
+            bool IsTrajectoryFinished() const {
+                return m_LeftFollower.finished && m_RightFollower.finished;
+            }
         };
     }
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Monotonic time source for everything that waits or times out. On the robot it is the steady clock,
+         * off the robot it can be advanced by hand so routines run as fast as the loop can be called.
+         */
+        class Clock {
+        public:
+            using Duration = std::chrono::nanoseconds;
+            using TimePoint = std::chrono::time_point<Clock, Duration>;
+
+            virtual ~Clock() = default;
+
+            virtual TimePoint Now() const = 0;
+        };
+
+        class SteadyClock : public Clock {
+        public:
+            TimePoint Now() const override {
+                return TimePoint(std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now().time_since_epoch()));
+            }
+        };
+
+        /**
+         * Only moves when told to, starts at zero
+         */
+        class SimulatedClock : public Clock {
+        protected:
+            TimePoint m_Now{};
+
+        public:
+            TimePoint Now() const override {
+                return m_Now;
+            }
+
+            template<typename TRep, typename TPeriod>
+            void Advance(std::chrono::duration<TRep, TPeriod> duration) {
+                m_Now += std::chrono::duration_cast<Duration>(duration);
+            }
+
+            void SetTime(TimePoint now) {
+                m_Now = now;
+            }
+        };
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <command.hpp>
+
+#include <lib/clock.hpp>
+#include <lib/mapped_file.hpp>
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#define COMMAND_LOG_MAGIC 0x4C434347 // "GCCL" in little endian
+#define COMMAND_LOG_VERSION 1
+#define COMMAND_LOG_CAPACITY 45000 // Records, fifteen minutes at fifty updates a second, recording stops after that
+#define COMMAND_LOG_MAX_ROUTINES 4 // Routines queued in one loop, more are dropped from the record
+#define COMMAND_LOG_MAX_ROUTINE_NAMES 32
+#define COMMAND_LOG_NAME_SIZE 48 // Characters including the terminator, longer names are truncated
+
+namespace garage {
+    namespace lib {
+        /**
+         * Written to the file as is like the flight recorder, bump the version when changing the layout.
+         * Axes are kept as doubles so a replay sees exactly what the robot did.
+         */
+        struct CommandRecord {
+            uint32_t sequence;
+            uint32_t reserved;
+            uint64_t timestamp; // Microseconds since the log was opened, by the robot clock
+            double driveForward, driveTurn, flipper, ballIntake, elevatorInput, outrigger, outriggerWheel;
+            double elevatorSetPoint, flipperAngle;
+            uint8_t hatchIntakeDown, offTheBooksModeEnabled, isQuickTurn, terminateRoutines;
+            uint8_t autoAlign, autoAlignPressed, autoAlignReleased, hasElevatorSetPoint;
+            uint8_t hasFlipperAngle, isReset, routineCount, reservedFlags;
+            uint8_t routines[COMMAND_LOG_MAX_ROUTINES]; // CommandRoutine values, which index the routine names of the header
+        };
+
+        struct CommandLogHeader {
+            uint32_t magic, version, headerSize, recordSize, capacity;
+            uint32_t routineNameCount;
+            uint64_t recordCount;
+            char routineNames[COMMAND_LOG_MAX_ROUTINE_NAMES][COMMAND_LOG_NAME_SIZE];
+        };
+
+        static_assert(std::is_trivially_copyable<CommandRecord>::value, "Command records are copied straight into the file");
+        static_assert(std::is_trivially_copyable<CommandLogHeader>::value, "The header is copied straight into the file");
+
+        /**
+         * Appends the command of every control loop to a preallocated memory mapped file so a match can be replayed
+         * off the robot. Routines are stored by their CommandRoutine value, the names given when opening are kept in
+         * the header so a replay can tell if they changed. Opening allocates, recording only copies into the mapping.
+         */
+        class CommandLog {
+        protected:
+            MappedFile m_File;
+            CommandLogHeader* m_Header = nullptr;
+            CommandRecord* m_Records = nullptr;
+            std::size_t m_RoutineCount = 0;
+            std::shared_ptr<Clock> m_Clock;
+            Clock::TimePoint m_OpenTime;
+            bool m_IsNextReset = false, m_HasWarnedFull = false, m_HasWarnedRoutine = false;
+
+        public:
+            CommandLog() = default;
+
+            CommandLog(const CommandLog&) = delete;
+
+            CommandLog& operator=(const CommandLog&) = delete;
+
+            ~CommandLog();
+
+            /**
+             * @param routineNames Name of each command routine, by its value
+             */
+            bool Open(const std::string& path, const std::vector<std::string>& routineNames, std::shared_ptr<Clock> clock);
+
+            void Close();
+
+            /**
+             * Asks the kernel to start writing out dirty pages, call somewhere the loop timing does not matter like disabled
+             */
+            void Flush() {
+                m_File.Flush();
+            }
+
+            bool IsOpen() const {
+                return m_Header != nullptr;
+            }
+
+            /**
+             * The next record is marked so the replay resets the robot before it, like entering a mode does
+             */
+            void MarkReset() {
+                m_IsNextReset = true;
+            }
+
+            void Record(const Command& command, const RoutineRequests& routines);
+        };
+
+        /**
+         * Reads a command log back, checking its layout and that its routine names match the ones given
+         */
+        class CommandLogReader {
+        protected:
+            std::vector<CommandRecord> m_Records;
+            std::size_t m_RoutineCount = 0;
+
+        public:
+            bool Open(const std::string& path, const std::vector<std::string>& routineNames);
+
+            std::size_t GetRecordCount() const {
+                return m_Records.size();
+            }
+
+            const CommandRecord& GetRecord(std::size_t index) const {
+                return m_Records[index];
+            }
+
+            /**
+             * Fills the command and its routines the way the robot had them, reusing the request vector so replaying does not allocate
+             */
+            void GetCommand(std::size_t index, Command& command, RoutineRequests& routines) const;
+        };
+    }
+}
@@ -13,9 +13,11 @@ namespace garage {
 
         protected:
             std::vector<std::shared_ptr<Controller>> m_Controllers;
-            std::shared_ptr<Controller> m_Controller, m_UnlockedController, m_ResetController;
+            // Owned by the list above, plain pointers so switching and running them does not touch reference counts
+            Controller* m_Controller = nullptr, * m_UnlockedController = nullptr, * m_ResetController = nullptr;
+            int m_ControlPhase;
 
-            virtual bool SetController(std::shared_ptr<Controller> controller) {
+            virtual bool SetController(Controller* controller) {
                 const bool different = controller != m_Controller;
                 if (different) {
                     if (controller != m_UnlockedController) {
@@ -23,14 +25,14 @@ namespace garage {
                     }
                     if (m_Controller) m_Controller->OnDisable();
                     m_Controller = controller;
-                    Log(Logger::LogLevel::k_Info, Logger::Format("Setting controller to: %s", FMT_STR(m_Controller->GetName())));
+                    Log(Logger::LogLevel::k_Info, "Setting controller to: {}", m_Controller ? m_Controller->GetName().c_str() : "None");
                     m_NetworkTable->PutString("Controller", m_Controller ? m_Controller->GetName() : "None");
                     if (controller) controller->OnEnable();
                 }
                 return different;
             }
 
-            virtual void AddController(std::shared_ptr<Controller> controller) {
+            virtual void AddController(const std::shared_ptr<Controller>& controller) {
                 if (controller) {
                     m_Controllers.push_back(controller);
                 } else {
@@ -38,7 +40,7 @@ namespace garage {
                 }
             }
 
-            virtual void SetUnlockedController(std::shared_ptr<Controller> controller) {
+            virtual void SetUnlockedController(Controller* controller) {
                 if (controller != m_UnlockedController) {
                     m_UnlockedController = controller;
                     // If we are unlocked and received this update, set to the new mode
@@ -48,13 +50,13 @@ namespace garage {
                 }
             }
 
-            virtual void SetResetController(std::shared_ptr<Controller> controller) {
+            virtual void SetResetController(Controller* controller) {
                 if (controller != m_ResetController) {
                     m_ResetController = controller;
                 }
             }
 
-            void UpdateUnlocked(Command& command) override {
+            void UpdateUnlocked(const Command& command) override {
                 if (m_Controller) {
                     m_Controller->ProcessCommand(command);
                 } else {
@@ -70,12 +72,21 @@ namespace garage {
                 }
             }
 
-            std::weak_ptr<TSubsystem> WeakFromThis() {
-                return std::dynamic_pointer_cast<TSubsystem>(shared_from_this());
+            /**
+             * Runs the active controller, timed as its own phase inside of Update
+             */
+            void RunController() {
+                if (m_Controller) {
+                    ProfilerScope controlScope(m_Profiler, m_ControlPhase);
+                    m_Controller->Control();
+                } else {
+                    LogSample(lib::Logger::LogLevel::k_Warning, "No controller detected");
+                }
             }
 
         public:
-            using Subsystem::Subsystem;
+            ControllableSubsystem(std::shared_ptr<Robot>& robot, const std::string& subsystemName)
+                    : Subsystem(robot, subsystemName), m_ControlPhase(m_Profiler.AddPhase(subsystemName + " Control")) {}
 
             void Reset() override {
                 Subsystem::Reset();
@@ -88,6 +99,11 @@ namespace garage {
                 Subsystem::Unlock();
                 SetController(m_UnlockedController);
             }
+
+            void RecordTelemetry(FlightRecorder& recorder, SubsystemTelemetry& telemetry) override {
+                Subsystem::RecordTelemetry(recorder, telemetry);
+                telemetry.controller = m_Controller ? recorder.Intern(m_Controller, m_Controller->GetName()) : FLIGHT_RECORDER_NO_NAME;
+            }
         };
     }
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <lib/routine.hpp>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <cstddef>
+
+#define COROUTINE_MAX_CHILDREN 8 // Routines one step can wait on together
+
+/**
+ * Steps of a CoroutineRoutine::Run body. Each macro has to be on its own line since the line number is the resume point,
+ * and locals do not survive a wait so anything kept across steps has to be a member.
+ */
+#define ROUTINE_BEGIN() switch (m_ResumePoint) { case 0:
+#define ROUTINE_AWAIT(CONDITION) do { m_ResumePoint = __LINE__; case __LINE__: if (!(CONDITION)) return false; } while (false)
+#define ROUTINE_YIELD() do { m_ResumePoint = __LINE__; return false; case __LINE__:; } while (false)
+#define ROUTINE_WAIT(MILLISECONDS) do { SetWait(std::chrono::milliseconds(MILLISECONDS)); ROUTINE_AWAIT(IsWaitOver() || SleepUntilWaitOver()); } while (false)
+#define ROUTINE_AWAIT_ALL(...) do { StartChildren(__VA_ARGS__); ROUTINE_AWAIT(RunChildren()); } while (false)
+#define ROUTINE_END() } return true
+
+namespace garage {
+    namespace lib {
+        /**
+         * Routine written as one function that picks up where it left off each update, instead of a tree of routines.
+         * Its state is the members of the object, so resuming never allocates. Other routines can be run as steps with
+         * ROUTINE_AWAIT_ALL, and it can be used anywhere another routine can.
+         *
+         *     ROUTINE_BEGIN();
+         *     m_HatchIntake->SetIntakeOpen(true);
+         *     ROUTINE_WAIT(600);
+         *     ROUTINE_AWAIT_ALL(m_SetElevatorPositionRoutine, m_SetFlipperAngleRoutine);
+         *     ROUTINE_END();
+         */
+        class CoroutineRoutine : public Routine {
+        protected:
+            int m_ResumePoint = 0;
+            bool m_IsDone = false;
+            Clock::TimePoint m_WaitEndTime;
+            std::array<Routine*, COROUTINE_MAX_CHILDREN> m_Children{};
+            std::array<bool, COROUTINE_MAX_CHILDREN> m_IsChildFinished{};
+            std::size_t m_ChildCount = 0;
+
+            /**
+             * Runs until the next wait, returns true once it has reached the end
+             */
+            virtual bool Run() = 0;
+
+            void Update() override;
+
+            bool CheckFinished() override;
+
+            /**
+             * Child routines are run by this one, so it has to require what they do
+             */
+            void AddRequirements(const std::shared_ptr<Routine>& routine);
+
+            void SetWait(std::chrono::milliseconds duration) {
+                m_WaitEndTime = m_Clock->Now() + duration;
+            }
+
+            bool IsWaitOver() const {
+                return m_Clock->Now() > m_WaitEndTime;
+            }
+
+            bool SleepUntilWaitOver() {
+                SleepUntil(m_WaitEndTime);
+                return false;
+            }
+
+            template<typename... TRoutines>
+            void StartChildren(const TRoutines& ... routines) {
+                static_assert(sizeof...(TRoutines) <= COROUTINE_MAX_CHILDREN, "Too many routines to wait on at once");
+                Routine* children[] = {routines.get()...};
+                m_ChildCount = sizeof...(TRoutines);
+                for (std::size_t i = 0; i < m_ChildCount; i++) {
+                    m_Children[i] = children[i];
+                    m_IsChildFinished[i] = false;
+                    m_Children[i]->Start();
+                }
+            }
+
+            /**
+             * Updates the children that are still going, true once all of them have finished
+             */
+            bool RunChildren();
+
+            void TerminateChildren();
+
+        public:
+            CoroutineRoutine(std::shared_ptr<Robot>& robot, const std::string& name);
+
+            void Start() override;
+
+            void Terminate() override;
+        };
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <lib/race_routine.hpp>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Runs the deadline routine and the others at the same time, finishes when the deadline routine does
+         * and terminates whichever others are still going
+         */
+        class DeadlineRoutine : public RaceRoutine {
+        protected:
+            bool CheckFinished() override;
+
+        public:
+            DeadlineRoutine(std::shared_ptr<Robot> robot, const std::string& name, const std::shared_ptr<Routine>& deadline, RoutineVector&& routines);
+        };
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <command.hpp>
+
+#include <lib/clock.hpp>
+#include <lib/mapped_file.hpp>
+
+#include <string>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+
+#define FLIGHT_RECORDER_MAGIC 0x52464347 // "GCFR" in little endian
+#define FLIGHT_RECORDER_VERSION 2
+#define FLIGHT_RECORDER_CAPACITY 30000 // Records, ten minutes at fifty updates a second, oldest are overwritten after that
+#define FLIGHT_RECORDER_MAX_SUBSYSTEMS 8
+#define FLIGHT_RECORDER_MAX_NAMES 128 // Subsystems, controllers and routines share one name table
+#define FLIGHT_RECORDER_NAME_SIZE 48 // Characters including the terminator, longer names are truncated
+#define FLIGHT_RECORDER_NO_NAME 0 // Name id recorded when there is no controller or routine
+
+namespace garage {
+    namespace lib {
+        class Routine;
+
+        class Subsystem;
+
+        /**
+         * Everything below is written to the file as is, so it only uses fixed width types and the decoder
+         * reads it back with the same definitions. Bump the version when changing the layout.
+         */
+        struct SubsystemTelemetry {
+            float position, velocity, output, current;
+            uint16_t controller;
+            uint8_t isLocked, reserved;
+        };
+
+        struct FlightRecord {
+            uint32_t sequence;
+            uint32_t reserved;
+            uint64_t timestamp; // Microseconds since the recorder was opened, by the robot clock
+            float driveForward, driveTurn, flipper, ballIntake, elevatorInput, outrigger, outriggerWheel;
+            uint8_t hatchIntakeDown, offTheBooksModeEnabled, isQuickTurn, reservedFlags;
+            uint16_t activeRoutine; // Oldest of the routines running at once
+            uint16_t activeRoutineCount;
+            SubsystemTelemetry subsystems[FLIGHT_RECORDER_MAX_SUBSYSTEMS];
+        };
+
+        struct FlightRecorderHeader {
+            uint32_t magic, version, headerSize, recordSize, capacity;
+            uint32_t subsystemCount, nameCount;
+            uint32_t reserved;
+            uint64_t recordCount; // Total records written, the newest is at (recordCount - 1) % capacity
+            uint16_t subsystemNames[FLIGHT_RECORDER_MAX_SUBSYSTEMS];
+            char names[FLIGHT_RECORDER_MAX_NAMES][FLIGHT_RECORDER_NAME_SIZE];
+        };
+
+        static_assert(std::is_trivially_copyable<FlightRecord>::value, "Flight records are copied straight into the file");
+        static_assert(std::is_trivially_copyable<FlightRecorderHeader>::value, "The header is copied straight into the file");
+
+        /**
+         * Appends one binary record per control loop to a preallocated memory mapped file, a ring of the last
+         * FLIGHT_RECORDER_CAPACITY loops. Opening allocates, recording only copies into the mapping.
+         * Use the FlightRecorderDecoder tool to convert a file to CSV.
+         */
+        class FlightRecorder {
+        protected:
+            MappedFile m_File;
+            FlightRecorderHeader* m_Header = nullptr;
+            FlightRecord* m_Records = nullptr;
+            // Name ids are looked up by the address of what owns the name, which lives as long as the robot
+            const void* m_NameKeys[FLIGHT_RECORDER_MAX_NAMES] = {};
+            bool m_HasWarnedNamesFull = false;
+            std::shared_ptr<Clock> m_Clock;
+            Clock::TimePoint m_OpenTime;
+
+        public:
+            FlightRecorder() = default;
+
+            FlightRecorder(const FlightRecorder&) = delete;
+
+            FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+            ~FlightRecorder();
+
+            /**
+             * Creates and maps the file, then registers the subsystems in the order their telemetry is recorded
+             */
+            bool Open(const std::string& path, const std::vector<std::shared_ptr<Subsystem>>& subsystems, std::shared_ptr<Clock> clock);
+
+            void Close();
+
+            /**
+             * Asks the kernel to start writing out dirty pages, call somewhere the loop timing does not matter like disabled
+             */
+            void Flush() {
+                m_File.Flush();
+            }
+
+            bool IsOpen() const {
+                return m_Header != nullptr;
+            }
+
+            /**
+             * Returns the id of a name, adding it to the table the first time the key is seen
+             */
+            uint16_t Intern(const void* key, const std::string& name);
+
+            void Record(const Command& command, const std::vector<std::shared_ptr<Routine>>& activeRoutines,
+                        const std::vector<std::shared_ptr<Subsystem>>& subsystems);
+        };
+    }
+}
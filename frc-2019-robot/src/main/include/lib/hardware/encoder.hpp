@@ -0,0 +1,16 @@
+#pragma once
+
+namespace garage {
+    namespace lib {
+        class Encoder {
+        public:
+            virtual ~Encoder() = default;
+
+            virtual double GetPosition() = 0;
+
+            virtual double GetVelocity() = 0;
+
+            virtual bool SetPosition(double position) = 0;
+        };
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <lib/hardware/servo.hpp>
+
+#include <frc/Servo.h>
+
+namespace garage {
+    namespace lib {
+        class FrcServo : public Servo {
+        protected:
+            frc::Servo m_Servo;
+
+        public:
+            explicit FrcServo(int channel) : m_Servo(channel) {}
+
+            void SetRaw(uint16_t value) override {
+                m_Servo.SetRaw(value);
+            }
+        };
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+/**
+ * Picks the implementation of each device at build time. Subsystems hold these types directly so motor calls are not virtual.
+ * Define GARAGE_SIMULATION to run without any vendor libraries.
+ */
+#ifdef GARAGE_SIMULATION
+
+#include <lib/hardware/simulated_servo.hpp>
+#include <lib/hardware/simulated_talon_srx.hpp>
+#include <lib/hardware/simulated_spark_max.hpp>
+
+namespace garage {
+    namespace lib {
+        using SparkMax = SimulatedSparkMax;
+        using TalonSRX = SimulatedTalonSRX;
+        using PwmServo = SimulatedServo;
+    }
+}
+
+#else
+
+#include <lib/hardware/frc_servo.hpp>
+#include <lib/hardware/talon_srx.hpp>
+#include <lib/hardware/spark_max.hpp>
+
+namespace garage {
+    namespace lib {
+        using SparkMax = RevSparkMax;
+        using TalonSRX = CtreTalonSRX;
+        using PwmServo = FrcServo;
+    }
+}
+
+#endif
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace garage {
+    namespace lib {
+        class LimitSwitch {
+        public:
+            virtual ~LimitSwitch() = default;
+
+            virtual bool Get() = 0;
+
+            /**
+             * Whether the motor controller it is wired to stops on its own when it is pressed
+             */
+            virtual bool EnableLimitSwitch(bool isEnabled) = 0;
+        };
+    }
+}
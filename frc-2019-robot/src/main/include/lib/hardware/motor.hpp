@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+
+namespace garage {
+    namespace lib {
+        enum class ControlType {
+            k_SmartMotion, k_SmartVelocity
+        };
+
+        enum class AccelStrategy {
+            k_Trapezoidal, k_SCurve
+        };
+
+        /**
+         * Motor controller driven with a percent output. Configuration returns whether the controller accepted it.
+         */
+        class Motor {
+        public:
+            virtual ~Motor() = default;
+
+            virtual bool RestoreFactoryDefaults() = 0;
+
+            virtual void Set(double output) = 0;
+
+            virtual double GetAppliedOutput() = 0;
+
+            virtual double GetOutputCurrent() = 0;
+
+            virtual void SetInverted(bool isInverted) = 0;
+
+            virtual bool SetBrakeMode(bool isBrakeMode) = 0;
+
+            virtual bool SetOpenLoopRampRate(double rampSeconds) = 0;
+
+            virtual bool EnableVoltageCompensation(double nominalVoltage) = 0;
+        };
+
+        /**
+         * Motor controller that also runs its own closed loop, with gains stored per slot
+         */
+        class ClosedLoopMotor : public Motor {
+        public:
+            virtual bool SetReference(double reference, ControlType controlType, int slot, double arbitraryFeedForward) = 0;
+
+            virtual bool SetClosedLoopRampRate(double rampSeconds) = 0;
+
+            virtual bool SetInputDeadband(double deadband) = 0;
+
+            virtual bool SetP(double p, int slot) = 0;
+
+            virtual bool SetI(double i, int slot) = 0;
+
+            virtual bool SetD(double d, int slot) = 0;
+
+            virtual bool SetFF(double ff, int slot) = 0;
+
+            virtual bool SetIZone(double iZone, int slot) = 0;
+
+            virtual bool SetIMaxAccum(double maxAccumulator, int slot) = 0;
+
+            virtual bool SetOutputRange(double minimum, double maximum, int slot) = 0;
+
+            virtual bool SetSmartMotionMaxVelocity(double maxVelocity, int slot) = 0;
+
+            virtual bool SetSmartMotionMinOutputVelocity(double minVelocity, int slot) = 0;
+
+            virtual bool SetSmartMotionMaxAccel(double maxAcceleration, int slot) = 0;
+
+            virtual bool SetSmartMotionAllowedClosedLoopError(double allowedError, int slot) = 0;
+
+            virtual bool SetSmartMotionAccelStrategy(AccelStrategy accelStrategy, int slot) = 0;
+
+            virtual uint16_t GetStickyFaults() = 0;
+
+            virtual bool ClearFaults() = 0;
+        };
+    }
+}
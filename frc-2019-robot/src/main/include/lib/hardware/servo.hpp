@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace garage {
+    namespace lib {
+        class Servo {
+        public:
+            virtual ~Servo() = default;
+
+            virtual void SetRaw(uint16_t value) = 0;
+        };
+    }
+}
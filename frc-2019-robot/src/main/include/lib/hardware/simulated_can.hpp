@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Latency added to the simulated getters that go over the CAN bus on the real devices, such as encoder position
+         * and output current. None by default, benchmarks set it to see how much of the loop is spent waiting on the bus.
+         */
+        class SimulatedCan {
+        protected:
+            static std::atomic<std::chrono::nanoseconds::rep>& GetLatencyCount() {
+                static std::atomic<std::chrono::nanoseconds::rep> s_Latency{0};
+                return s_Latency;
+            }
+
+        public:
+            static void SetLatency(std::chrono::nanoseconds latency) {
+                GetLatencyCount().store(latency.count(), std::memory_order_relaxed);
+            }
+
+            static std::chrono::nanoseconds GetLatency() {
+                return std::chrono::nanoseconds(GetLatencyCount().load(std::memory_order_relaxed));
+            }
+
+            /**
+             * Blocks the calling thread for the latency, like waiting on a reply from the device
+             */
+            static void Read() {
+                const auto latency = GetLatency();
+                if (latency.count() > 0) std::this_thread::sleep_for(latency);
+            }
+        };
+    }
+}
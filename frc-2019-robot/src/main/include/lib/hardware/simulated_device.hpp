@@ -0,0 +1,64 @@
+#pragma once
+
+#include <lib/logger.hpp>
+
+#include <vector>
+#include <algorithm>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Keeps track of every live simulated device of one type by id so the simulation can find what a subsystem
+         * created without the subsystem exposing it. Ids can be shared, the hardware map reuses some CAN ids.
+         */
+        template<typename TDevice>
+        class SimulatedDevice {
+        protected:
+            int m_DeviceId;
+
+            static std::vector<SimulatedDevice*>& GetRegistry() {
+                static std::vector<SimulatedDevice*> s_Registry;
+                return s_Registry;
+            }
+
+        public:
+            SimulatedDevice(const char* typeName, int deviceId) : m_DeviceId(deviceId) {
+                auto& registry = GetRegistry();
+                if (Find(deviceId)) {
+                    Logger::Log(Logger::LogLevel::k_Warning, "[Simulation] More than one {} with id {}", typeName, deviceId);
+                }
+                registry.push_back(this);
+            }
+
+            SimulatedDevice(const SimulatedDevice&) = delete;
+
+            SimulatedDevice& operator=(const SimulatedDevice&) = delete;
+
+            virtual ~SimulatedDevice() {
+                auto& registry = GetRegistry();
+                registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+            }
+
+            int GetDeviceId() const {
+                return m_DeviceId;
+            }
+
+            /**
+             * Returns the first device created with the id, or null if there is none
+             */
+            static TDevice* Find(int deviceId) {
+                for (auto device : GetRegistry()) {
+                    if (device->m_DeviceId == deviceId) return static_cast<TDevice*>(device);
+                }
+                return nullptr;
+            }
+
+            template<typename TFunction>
+            static void ForEach(TFunction function) {
+                for (auto device : GetRegistry()) {
+                    function(*static_cast<TDevice*>(device));
+                }
+            }
+        };
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <lib/hardware/servo.hpp>
+#include <lib/hardware/simulated_device.hpp>
+
+namespace garage {
+    namespace lib {
+        class SimulatedServo : public Servo, public SimulatedDevice<SimulatedServo> {
+        protected:
+            uint16_t m_Raw = 0;
+
+        public:
+            explicit SimulatedServo(int channel) : SimulatedDevice("Servo", channel) {}
+
+            void SetRaw(uint16_t value) override {
+                m_Raw = value;
+            }
+
+            uint16_t GetRaw() const {
+                return m_Raw;
+            }
+        };
+    }
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <lib/hardware/motor.hpp>
+#include <lib/hardware/encoder.hpp>
+#include <lib/hardware/limit_switch.hpp>
+#include <lib/hardware/simulated_can.hpp>
+#include <lib/hardware/simulated_device.hpp>
+
+#include <array>
+
+#define SIMULATED_SPARK_MAX_SLOTS 4
+
+namespace garage {
+    namespace lib {
+        class SimulatedEncoder : public Encoder {
+        protected:
+            double m_RawPosition = 0.0, m_Offset = 0.0, m_Velocity = 0.0;
+
+        public:
+            double GetPosition() override {
+                SimulatedCan::Read();
+                return m_RawPosition + m_Offset;
+            }
+
+            double GetVelocity() override {
+                SimulatedCan::Read();
+                return m_Velocity;
+            }
+
+            bool SetPosition(double position) override {
+                m_Offset = position - m_RawPosition;
+                return true;
+            }
+
+            /**
+             * Called by the simulation, the raw position is where the mechanism is before any offset from SetPosition
+             */
+            void SetSimulatedState(double rawPosition, double velocity) {
+                m_RawPosition = rawPosition;
+                m_Velocity = velocity;
+            }
+        };
+
+        class SimulatedLimitSwitch : public LimitSwitch {
+        protected:
+            bool m_IsPressed = false, m_IsEnabled = false;
+
+        public:
+            bool Get() override {
+                return m_IsPressed;
+            }
+
+            bool EnableLimitSwitch(bool isEnabled) override {
+                m_IsEnabled = isEnabled;
+                return true;
+            }
+
+            bool IsEnabled() const {
+                return m_IsEnabled;
+            }
+
+            void SetPressed(bool isPressed) {
+                m_IsPressed = isPressed;
+            }
+        };
+
+        /**
+         * Records everything the code asks of a Spark Max. Without a model driving it, open loop output is applied as is,
+         * closed loop output stays where it was, followers mirror their leader and the encoder does not move.
+         */
+        class SimulatedSparkMax : public ClosedLoopMotor, public SimulatedDevice<SimulatedSparkMax> {
+        public:
+            struct Gains {
+                double p = 0.0, i = 0.0, d = 0.0, ff = 0.0, iZone = 0.0, iMaxAccum = 0.0;
+                double minOutput = -1.0, maxOutput = 1.0;
+                double maxVelocity = 0.0, minOutputVelocity = 0.0, maxAcceleration = 0.0, allowedError = 0.0;
+                AccelStrategy accelStrategy = AccelStrategy::k_Trapezoidal;
+            };
+
+        protected:
+            SimulatedSparkMax* m_Leader = nullptr;
+            bool m_IsFollowerInverted = false, m_IsInverted = false, m_IsBrakeMode = false, m_IsClosedLoop = false, m_IsModeled = false;
+            double m_Output = 0.0, m_AppliedOutput = 0.0, m_Current = 0.0;
+            double m_Reference = 0.0, m_ArbitraryFeedForward = 0.0;
+            double m_OpenLoopRampRate = 0.0, m_ClosedLoopRampRate = 0.0, m_NominalVoltage = 0.0, m_InputDeadband = 0.0;
+            ControlType m_ControlType = ControlType::k_SmartMotion;
+            int m_Slot = 0;
+            std::array<Gains, SIMULATED_SPARK_MAX_SLOTS> m_Gains{};
+            uint16_t m_StickyFaults = 0;
+            SimulatedEncoder m_Encoder;
+            SimulatedLimitSwitch m_ForwardLimitSwitch, m_ReverseLimitSwitch;
+
+            Gains* GetSlot(int slot);
+
+        public:
+            explicit SimulatedSparkMax(int deviceId) : SimulatedDevice("Spark Max", deviceId) {}
+
+            SimulatedEncoder& GetEncoder() {
+                return m_Encoder;
+            }
+
+            SimulatedLimitSwitch& GetForwardLimitSwitch() {
+                return m_ForwardLimitSwitch;
+            }
+
+            SimulatedLimitSwitch& GetReverseLimitSwitch() {
+                return m_ReverseLimitSwitch;
+            }
+
+            bool Follow(SimulatedSparkMax& leader, bool isInverted = false);
+
+            bool RestoreFactoryDefaults() override;
+
+            void Set(double output) override;
+
+            double GetAppliedOutput() override;
+
+            double GetOutputCurrent() override {
+                SimulatedCan::Read();
+                return m_Current;
+            }
+
+            void SetInverted(bool isInverted) override {
+                m_IsInverted = isInverted;
+            }
+
+            bool SetBrakeMode(bool isBrakeMode) override {
+                m_IsBrakeMode = isBrakeMode;
+                return true;
+            }
+
+            bool SetOpenLoopRampRate(double rampSeconds) override {
+                m_OpenLoopRampRate = rampSeconds;
+                return true;
+            }
+
+            bool EnableVoltageCompensation(double nominalVoltage) override {
+                m_NominalVoltage = nominalVoltage;
+                return true;
+            }
+
+            bool SetReference(double reference, ControlType controlType, int slot, double arbitraryFeedForward) override;
+
+            bool SetClosedLoopRampRate(double rampSeconds) override {
+                m_ClosedLoopRampRate = rampSeconds;
+                return true;
+            }
+
+            bool SetInputDeadband(double deadband) override {
+                m_InputDeadband = deadband;
+                return true;
+            }
+
+            bool SetP(double p, int slot) override;
+
+            bool SetI(double i, int slot) override;
+
+            bool SetD(double d, int slot) override;
+
+            bool SetFF(double ff, int slot) override;
+
+            bool SetIZone(double iZone, int slot) override;
+
+            bool SetIMaxAccum(double maxAccumulator, int slot) override;
+
+            bool SetOutputRange(double minimum, double maximum, int slot) override;
+
+            bool SetSmartMotionMaxVelocity(double maxVelocity, int slot) override;
+
+            bool SetSmartMotionMinOutputVelocity(double minVelocity, int slot) override;
+
+            bool SetSmartMotionMaxAccel(double maxAcceleration, int slot) override;
+
+            bool SetSmartMotionAllowedClosedLoopError(double allowedError, int slot) override;
+
+            bool SetSmartMotionAccelStrategy(AccelStrategy accelStrategy, int slot) override;
+
+            uint16_t GetStickyFaults() override {
+                SimulatedCan::Read();
+                return m_StickyFaults;
+            }
+
+            bool ClearFaults() override {
+                m_StickyFaults = 0;
+                return true;
+            }
+
+            /* Read and written by the simulation */
+
+            SimulatedSparkMax* GetLeader() const {
+                return m_Leader;
+            }
+
+            bool IsFollowerInverted() const {
+                return m_IsFollowerInverted;
+            }
+
+            bool IsInverted() const {
+                return m_IsInverted;
+            }
+
+            bool IsBrakeMode() const {
+                return m_IsBrakeMode;
+            }
+
+            bool IsClosedLoop() const {
+                return m_IsClosedLoop;
+            }
+
+            /**
+             * Last open loop output, before ramping and inversion
+             */
+            double GetOutput() const {
+                return m_Output;
+            }
+
+            double GetReference() const {
+                return m_Reference;
+            }
+
+            ControlType GetControlType() const {
+                return m_ControlType;
+            }
+
+            int GetReferenceSlot() const {
+                return m_Slot;
+            }
+
+            double GetArbitraryFeedForward() const {
+                return m_ArbitraryFeedForward;
+            }
+
+            const Gains& GetGains(int slot) const {
+                return m_Gains[slot];
+            }
+
+            double GetOpenLoopRampRate() const {
+                return m_OpenLoopRampRate;
+            }
+
+            double GetClosedLoopRampRate() const {
+                return m_ClosedLoopRampRate;
+            }
+
+            double GetNominalVoltage() const {
+                return m_NominalVoltage;
+            }
+
+            double GetInputDeadband() const {
+                return m_InputDeadband;
+            }
+
+            /**
+             * Once a model sets the applied output it is reported as is, even for followers
+             */
+            void SetAppliedOutput(double appliedOutput) {
+                m_AppliedOutput = appliedOutput;
+                m_IsModeled = true;
+            }
+
+            void SetOutputCurrent(double current) {
+                m_Current = current;
+            }
+
+            void SetStickyFaults(uint16_t stickyFaults) {
+                m_StickyFaults = stickyFaults;
+            }
+        };
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <lib/hardware/motor.hpp>
+#include <lib/hardware/simulated_can.hpp>
+#include <lib/hardware/simulated_device.hpp>
+
+#include <garage_math/garage_math.hpp>
+
+namespace garage {
+    namespace lib {
+        class SimulatedTalonSRX : public Motor, public SimulatedDevice<SimulatedTalonSRX> {
+        protected:
+            bool m_IsInverted = false, m_IsBrakeMode = false;
+            double m_AppliedOutput = 0.0, m_Current = 0.0, m_OpenLoopRampRate = 0.0, m_NominalVoltage = 0.0;
+
+        public:
+            explicit SimulatedTalonSRX(int deviceId) : SimulatedDevice("Talon SRX", deviceId) {}
+
+            bool RestoreFactoryDefaults() override {
+                m_IsInverted = false;
+                m_IsBrakeMode = false;
+                m_OpenLoopRampRate = 0.0;
+                m_NominalVoltage = 0.0;
+                return true;
+            }
+
+            void Set(double output) override {
+                m_AppliedOutput = math::clamp(output, -1.0, 1.0);
+            }
+
+            double GetAppliedOutput() override {
+                return m_AppliedOutput;
+            }
+
+            double GetOutputCurrent() override {
+                SimulatedCan::Read();
+                return m_Current;
+            }
+
+            void SetInverted(bool isInverted) override {
+                m_IsInverted = isInverted;
+            }
+
+            bool SetBrakeMode(bool isBrakeMode) override {
+                m_IsBrakeMode = isBrakeMode;
+                return true;
+            }
+
+            bool SetOpenLoopRampRate(double rampSeconds) override {
+                m_OpenLoopRampRate = rampSeconds;
+                return true;
+            }
+
+            bool EnableVoltageCompensation(double nominalVoltage) override {
+                m_NominalVoltage = nominalVoltage;
+                return true;
+            }
+
+            bool IsInverted() const {
+                return m_IsInverted;
+            }
+
+            bool IsBrakeMode() const {
+                return m_IsBrakeMode;
+            }
+
+            double GetOpenLoopRampRate() const {
+                return m_OpenLoopRampRate;
+            }
+
+            void SetOutputCurrent(double current) {
+                m_Current = current;
+            }
+        };
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <lib/hardware/motor.hpp>
+#include <lib/hardware/encoder.hpp>
+#include <lib/hardware/limit_switch.hpp>
+
+#include <rev/CANSparkMax.h>
+
+namespace garage {
+    namespace lib {
+        class RevSparkMaxEncoder : public Encoder {
+        protected:
+            rev::CANEncoder m_Encoder;
+
+        public:
+            explicit RevSparkMaxEncoder(rev::CANEncoder encoder) : m_Encoder(encoder) {}
+
+            double GetPosition() override;
+
+            double GetVelocity() override;
+
+            bool SetPosition(double position) override;
+        };
+
+        class RevSparkMaxLimitSwitch : public LimitSwitch {
+        protected:
+            rev::CANDigitalInput m_LimitSwitch;
+
+        public:
+            explicit RevSparkMaxLimitSwitch(rev::CANDigitalInput limitSwitch) : m_LimitSwitch(limitSwitch) {}
+
+            bool Get() override;
+
+            bool EnableLimitSwitch(bool isEnabled) override;
+        };
+
+        /**
+         * Brushless Spark Max with its built in encoder and normally open limit switch inputs
+         */
+        class RevSparkMax : public ClosedLoopMotor {
+        protected:
+            rev::CANSparkMax m_Spark;
+            rev::CANPIDController m_Controller = m_Spark.GetPIDController();
+            RevSparkMaxEncoder m_Encoder{m_Spark.GetEncoder()};
+            RevSparkMaxLimitSwitch
+                    m_ForwardLimitSwitch{m_Spark.GetForwardLimitSwitch(rev::CANDigitalInput::LimitSwitchPolarity::kNormallyOpen)},
+                    m_ReverseLimitSwitch{m_Spark.GetReverseLimitSwitch(rev::CANDigitalInput::LimitSwitchPolarity::kNormallyOpen)};
+
+        public:
+            explicit RevSparkMax(int deviceId);
+
+            RevSparkMax(const RevSparkMax&) = delete;
+
+            RevSparkMax& operator=(const RevSparkMax&) = delete;
+
+            Encoder& GetEncoder() {
+                return m_Encoder;
+            }
+
+            LimitSwitch& GetForwardLimitSwitch() {
+                return m_ForwardLimitSwitch;
+            }
+
+            LimitSwitch& GetReverseLimitSwitch() {
+                return m_ReverseLimitSwitch;
+            }
+
+            bool Follow(RevSparkMax& leader, bool isInverted = false);
+
+            bool RestoreFactoryDefaults() override;
+
+            void Set(double output) override;
+
+            double GetAppliedOutput() override;
+
+            double GetOutputCurrent() override;
+
+            void SetInverted(bool isInverted) override;
+
+            bool SetBrakeMode(bool isBrakeMode) override;
+
+            bool SetOpenLoopRampRate(double rampSeconds) override;
+
+            bool EnableVoltageCompensation(double nominalVoltage) override;
+
+            bool SetReference(double reference, ControlType controlType, int slot, double arbitraryFeedForward) override;
+
+            bool SetClosedLoopRampRate(double rampSeconds) override;
+
+            bool SetInputDeadband(double deadband) override;
+
+            bool SetP(double p, int slot) override;
+
+            bool SetI(double i, int slot) override;
+
+            bool SetD(double d, int slot) override;
+
+            bool SetFF(double ff, int slot) override;
+
+            bool SetIZone(double iZone, int slot) override;
+
+            bool SetIMaxAccum(double maxAccumulator, int slot) override;
+
+            bool SetOutputRange(double minimum, double maximum, int slot) override;
+
+            bool SetSmartMotionMaxVelocity(double maxVelocity, int slot) override;
+
+            bool SetSmartMotionMinOutputVelocity(double minVelocity, int slot) override;
+
+            bool SetSmartMotionMaxAccel(double maxAcceleration, int slot) override;
+
+            bool SetSmartMotionAllowedClosedLoopError(double allowedError, int slot) override;
+
+            bool SetSmartMotionAccelStrategy(AccelStrategy accelStrategy, int slot) override;
+
+            uint16_t GetStickyFaults() override;
+
+            bool ClearFaults() override;
+        };
+    }
+}
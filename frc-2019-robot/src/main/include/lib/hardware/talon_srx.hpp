@@ -0,0 +1,40 @@
+#pragma once
+
+#include <lib/hardware/motor.hpp>
+
+#include <ctre/phoenix/motorcontrol/can/TalonSRX.h>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Talon SRX in percent output. Factory defaults and voltage compensation wait up to CONFIG_TIMEOUT for the controller to answer.
+         */
+        class CtreTalonSRX : public Motor {
+        protected:
+            ctre::phoenix::motorcontrol::can::TalonSRX m_Talon;
+
+        public:
+            explicit CtreTalonSRX(int deviceId);
+
+            CtreTalonSRX(const CtreTalonSRX&) = delete;
+
+            CtreTalonSRX& operator=(const CtreTalonSRX&) = delete;
+
+            bool RestoreFactoryDefaults() override;
+
+            void Set(double output) override;
+
+            double GetAppliedOutput() override;
+
+            double GetOutputCurrent() override;
+
+            void SetInverted(bool isInverted) override;
+
+            bool SetBrakeMode(bool isBrakeMode) override;
+
+            bool SetOpenLoopRampRate(double rampSeconds) override;
+
+            bool EnableVoltageCompensation(double nominalVoltage) override;
+        };
+    }
+}
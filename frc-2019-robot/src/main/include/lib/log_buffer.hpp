@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#define LOG_BUFFER_SIZE 256 // Characters, anything past this is truncated
+
+namespace garage {
+    namespace lib {
+        /**
+         * Fixed size character buffer that log lines are composed in without touching the heap.
+         * Formatting is type safe, each {} in the format is replaced by the next argument based on its static type.
+         */
+        class LogBuffer {
+        protected:
+            char m_Data[LOG_BUFFER_SIZE];
+            std::size_t m_Length = 0;
+
+            void AppendSigned(long long value);
+
+            void AppendUnsigned(unsigned long long value);
+
+            void AppendFloating(double value);
+
+            void FormatRemaining(const char* format) {
+                Append(format);
+            }
+
+            template<typename TFirst, typename... TRest>
+            void FormatRemaining(const char* format, const TFirst& first, const TRest& ... rest) {
+                const char* placeholder = std::strstr(format, "{}");
+                if (placeholder) {
+                    Append(format, static_cast<std::size_t>(placeholder - format));
+                    Append(first);
+                    FormatRemaining(placeholder + 2, rest...);
+                } else {
+                    Append(format);
+                }
+            }
+
+        public:
+            void Clear() {
+                m_Length = 0;
+            }
+
+            void Append(const char* text, std::size_t length);
+
+            void Append(const char* text) {
+                Append(text, std::strlen(text));
+            }
+
+            void Append(const std::string& text) {
+                Append(text.data(), text.size());
+            }
+
+            void Append(char character) {
+                Append(&character, 1);
+            }
+
+            void Append(bool value) {
+                Append(value ? "true" : "false");
+            }
+
+            template<typename T>
+            typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type Append(T value) {
+                AppendSigned(value);
+            }
+
+            template<typename T>
+            typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type Append(T value) {
+                AppendUnsigned(value);
+            }
+
+            template<typename T>
+            typename std::enable_if<std::is_floating_point<T>::value>::type Append(T value) {
+                AppendFloating(value);
+            }
+
+            template<typename T>
+            typename std::enable_if<std::is_enum<T>::value>::type Append(T value) {
+                Append(static_cast<typename std::underlying_type<T>::type>(value));
+            }
+
+            template<typename TRep, typename TPeriod>
+            void Append(std::chrono::duration<TRep, TPeriod> duration) {
+                Append(duration.count());
+            }
+
+            /**
+             * Appends the format with each {} replaced by the next argument.
+             * Extra placeholders are left as is and extra arguments are ignored.
+             */
+            template<typename... TArgs>
+            void Format(const char* format, const TArgs& ... arguments) {
+                FormatRemaining(format, arguments...);
+            }
+
+            const char* GetData() const {
+                return m_Data;
+            }
+
+            std::size_t GetLength() const {
+                return m_Length;
+            }
+        };
+    }
+}
@@ -1,9 +1,23 @@
 #pragma once
 
+#include <lib/log_buffer.hpp>
+
 #include <string>
+#include <atomic>
+#include <thread>
 
 #define FMT_STR(STRING) STRING.c_str()
 
+#define LOG_RECORD_SIZE LOG_BUFFER_SIZE // Characters, longer lines are truncated in asynchronous mode
+#define LOG_QUEUE_CAPACITY 512 // Records, must be a power of two
+#define LOG_FLUSH_INTERVAL 5 // Milliseconds the background thread sleeps when the queue is empty
+
+// Highest level that is compiled in, anything more verbose is removed at compile time regardless of the runtime level.
+// Competition builds set this to info so debug and verbose logging cost nothing.
+#ifndef LOG_COMPILED_LEVEL
+#define LOG_COMPILED_LEVEL 6
+#endif
+
 namespace garage {
     namespace lib {
         class Logger {
@@ -12,15 +26,86 @@ namespace garage {
                 k_Silent = 0, k_Fatal = 1, k_Error = 2, k_Warning = 3, k_Info = 4, k_Debug = 5, k_Verbose = 6
             };
 
+            static constexpr LogLevel k_CompiledLogLevel = static_cast<LogLevel>(LOG_COMPILED_LEVEL);
+
         protected:
-            static LogLevel s_LogLevel;
+            static std::atomic<LogLevel> s_LogLevel;
+            static std::atomic<bool> s_IsAsync;
+            static std::atomic<unsigned long> s_DroppedRecords;
+            static std::thread s_Thread;
+
+            static void Write(LogLevel logLevel, const char* log, std::size_t length);
+
+            static void WriteSynchronous(const char* log, std::size_t length);
+
+            static void RunBackend();
+
+            template<typename... TArgs>
+            static void LogEnabled(LogLevel logLevel, const std::string* prefix, const char* format, const TArgs& ... arguments) {
+                auto& buffer = GetThreadBuffer();
+                buffer.Clear();
+                if (prefix) buffer.Append(*prefix);
+                buffer.Format(format, arguments...);
+                Log(logLevel, buffer);
+            }
 
         public:
             static std::string Format(const std::string& format, ...);
 
             static void SetLogLevel(LogLevel logLevel);
 
-            static void Log(LogLevel logLevel, std::string log);
+            /**
+             * Checked before formatting anything. The compiled level is a constant, so with a constant level
+             * at the call site a call above it is dead code and removed entirely.
+             */
+            static bool IsEnabled(LogLevel logLevel) {
+                return logLevel <= k_CompiledLogLevel && logLevel <= s_LogLevel.load(std::memory_order_relaxed);
+            }
+
+            static void Log(LogLevel logLevel, const std::string& log);
+
+            static void Log(LogLevel logLevel, const LogBuffer& log);
+
+            /**
+             * Buffer owned by the calling thread to compose a line in, which is reused by every typed log call
+             */
+            static LogBuffer& GetThreadBuffer();
+
+            /**
+             * Formats into the thread buffer with {} placeholders and logs, without any heap allocation.
+             * Nothing is formatted unless the level is enabled.
+             */
+            template<typename... TArgs>
+            static void Log(LogLevel logLevel, const char* format, const TArgs& ... arguments) {
+                if (IsEnabled(logLevel)) LogEnabled(logLevel, nullptr, format, arguments...);
+            }
+
+            /**
+             * Same as the typed log but with a prefix, such as a subsystem name, composed in the same pass
+             */
+            template<typename... TArgs>
+            static void LogWithPrefix(LogLevel logLevel, const std::string& prefix, const char* format, const TArgs& ... arguments) {
+                if (IsEnabled(logLevel)) LogEnabled(logLevel, &prefix, format, arguments...);
+            }
+
+            /**
+             * Switches to asynchronous mode, where logging only pushes a record into a lock-free queue and
+             * a background thread writes it out. When the queue is full records are dropped and counted instead of blocking.
+             */
+            static void StartAsync();
+
+            /**
+             * Writes out everything that is queued, stops the background thread and goes back to writing synchronously.
+             */
+            static void StopAsync();
+
+            static bool IsAsync() {
+                return s_IsAsync.load(std::memory_order_relaxed);
+            }
+
+            static unsigned long GetDroppedCount() {
+                return s_DroppedRecords.load(std::memory_order_relaxed);
+            }
         };
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableEntry.h>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#define PROFILER_MAX_PHASES 48
+#define PROFILER_PUBLISH_INTERVAL 250 // Loops, five seconds at fifty updates a second, the histograms only cover this window
+#define PROFILER_MIN_SHIFT 6 // Durations under 2^6 nanoseconds all land in the first bucket
+#define PROFILER_SUB_BUCKETS 4 // Buckets per power of two, so percentiles are within twenty five percent
+#define PROFILER_BUCKET_COUNT 84 // Covers up to about 120 milliseconds, longer durations go in the last bucket
+
+namespace garage {
+    namespace lib {
+        /**
+         * Histogram with buckets that grow logarithmically, recording is a couple of shifts and an increment
+         */
+        class PhaseHistogram {
+        protected:
+            std::array<uint32_t, PROFILER_BUCKET_COUNT> m_Buckets{};
+            uint32_t m_Count = 0, m_Max = 0;
+
+            static int GetBucket(uint32_t nanoseconds);
+
+            static uint32_t GetBucketUpperBound(int bucket);
+
+        public:
+            void Record(uint32_t nanoseconds);
+
+            void Clear();
+
+            /**
+             * Upper bound of the bucket the percentile falls in, in nanoseconds
+             */
+            uint32_t GetPercentile(double fraction) const;
+
+            uint32_t GetMax() const {
+                return m_Max;
+            }
+
+            uint32_t GetCount() const {
+                return m_Count;
+            }
+        };
+
+        /**
+         * Times the phases of the control loop with a steady clock. Phases are registered once at initialization
+         * and get a fixed slot, so recording does not allocate or look anything up. Every PROFILER_PUBLISH_INTERVAL
+         * loops the p50, p99 and max of each phase over that window are published in microseconds and the window starts over.
+         */
+        class LoopProfiler {
+        protected:
+            struct Phase {
+                std::string name;
+                PhaseHistogram histogram;
+                nt::NetworkTableEntry p50Entry, p99Entry, maxEntry;
+            };
+
+            std::shared_ptr<nt::NetworkTable> m_NetworkTable;
+            std::vector<Phase> m_Phases;
+            bool m_IsEnabled = true;
+            unsigned long m_LoopCount = 0;
+
+            void Publish();
+
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            /**
+             * Must be called before any phases are added, each phase gets a sub table
+             */
+            void Initialize(std::shared_ptr<nt::NetworkTable> networkTable);
+
+            /**
+             * Returns the slot to record the phase in, or -1 once all slots are used, which is ignored when recording
+             */
+            int AddPhase(const std::string& name);
+
+            void Record(int phase, Clock::duration duration) {
+                if (phase >= 0) {
+                    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+                    m_Phases[phase].histogram.Record(nanoseconds > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(nanoseconds));
+                }
+            }
+
+            /**
+             * Call once at the end of every loop, publishes when the window is complete
+             */
+            void EndLoop();
+
+            void SetEnabled(bool isEnabled) {
+                m_IsEnabled = isEnabled;
+            }
+
+            bool IsEnabled() const {
+                return m_IsEnabled;
+            }
+        };
+
+        /**
+         * Records the time from construction to destruction in a phase, does not read the clock when profiling is off
+         */
+        class ProfilerScope {
+        protected:
+            LoopProfiler& m_Profiler;
+            int m_Phase;
+            LoopProfiler::Clock::time_point m_Start;
+
+        public:
+            ProfilerScope(LoopProfiler& profiler, int phase) : m_Profiler(profiler), m_Phase(profiler.IsEnabled() ? phase : -1) {
+                if (m_Phase >= 0) m_Start = LoopProfiler::Clock::now();
+            }
+
+            ProfilerScope(const ProfilerScope&) = delete;
+
+            ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+            ~ProfilerScope() {
+                if (m_Phase >= 0) m_Profiler.Record(m_Phase, LoopProfiler::Clock::now() - m_Start);
+            }
+        };
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace garage {
+    namespace lib {
+        /**
+         * A file of a fixed size created up front and mapped into memory, writes to it are plain memory writes.
+         * Shared by the flight recorder and the command log, which write their records straight into the mapping.
+         */
+        class MappedFile {
+        protected:
+            int m_FileDescriptor = -1;
+            void* m_Mapping = nullptr;
+            std::size_t m_Size = 0;
+
+        public:
+            MappedFile() = default;
+
+            MappedFile(const MappedFile&) = delete;
+
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            ~MappedFile() {
+                Close();
+            }
+
+            /**
+             * Replaces whatever was at the path, errors are logged with the name of the owner
+             */
+            bool Open(const std::string& path, std::size_t size, const char* ownerName);
+
+            /**
+             * Waits for everything to be written out, then unmaps and closes the file
+             */
+            void Close();
+
+            /**
+             * Asks the kernel to start writing out dirty pages, call somewhere the loop timing does not matter like disabled
+             */
+            void Flush();
+
+            bool IsOpen() const {
+                return m_Mapping != nullptr;
+            }
+
+            void* GetData() const {
+                return m_Mapping;
+            }
+
+            std::size_t GetSize() const {
+                return m_Size;
+            }
+        };
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Bounded lock-free queue with many producers and a single consumer.
+         * Each cell carries a sequence number so producers only contend on the enqueue position and never wait on the consumer.
+         * When the buffer is full pushing fails immediately instead of blocking.
+         */
+        template<typename T, std::size_t Capacity>
+        class MpscRingBuffer {
+            static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+        protected:
+            struct Cell {
+                std::atomic<std::size_t> sequence;
+                T data;
+            };
+
+            static constexpr std::size_t k_Mask = Capacity - 1;
+
+            std::array<Cell, Capacity> m_Cells;
+            alignas(64) std::atomic<std::size_t> m_EnqueuePosition{0};
+            alignas(64) std::size_t m_DequeuePosition = 0;
+
+        public:
+            MpscRingBuffer() {
+                for (std::size_t i = 0; i < Capacity; i++) {
+                    m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            MpscRingBuffer(const MpscRingBuffer&) = delete;
+
+            MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+            /**
+             * Claims a cell and hands it to the fill function so the record is written in place.
+             * Safe to call from any number of threads.
+             *
+             * @return False if the buffer is full, the fill function is not called in that case
+             */
+            template<typename TFill>
+            bool TryPush(TFill&& fill) {
+                std::size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+                for (;;) {
+                    Cell& cell = m_Cells[position & k_Mask];
+                    const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                    const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+                    if (difference == 0) {
+                        if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                            fill(cell.data);
+                            cell.sequence.store(position + 1, std::memory_order_release);
+                            return true;
+                        }
+                    } else if (difference < 0) {
+                        return false;
+                    } else {
+                        position = m_EnqueuePosition.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            /**
+             * Hands the oldest record to the consume function and frees its cell.
+             * Must only be called from the single consumer thread.
+             *
+             * @return False if there was nothing to consume
+             */
+            template<typename TConsume>
+            bool TryPop(TConsume&& consume) {
+                Cell& cell = m_Cells[m_DequeuePosition & k_Mask];
+                const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(m_DequeuePosition + 1) < 0) {
+                    return false;
+                }
+                consume(cell.data);
+                cell.sequence.store(m_DequeuePosition + Capacity, std::memory_order_release);
+                m_DequeuePosition++;
+                return true;
+            }
+        };
+    }
+}
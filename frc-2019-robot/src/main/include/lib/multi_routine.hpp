@@ -12,6 +12,11 @@ namespace garage {
         class MultiRoutine : public Routine {
         protected:
             RoutineVector m_SubRoutines;
+
+            /**
+             * Requires everything any sub routine does, so the whole group holds its subsystems until it finishes
+             */
+            void AddSubRoutineRequirements();
         public:
             MultiRoutine(std::shared_ptr<Robot> robot, const std::string& name, RoutineVector&& routines);
 
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <lib/parallel_routine.hpp>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Runs the sub routines at the same time and finishes as soon as any one of them does, terminating the rest
+         */
+        class RaceRoutine : public ParallelRoutine {
+        protected:
+            bool CheckFinished() override;
+
+        public:
+            using ParallelRoutine::ParallelRoutine;
+
+            void Terminate() override;
+        };
+    }
+}
@@ -1,22 +1,110 @@
 #pragma once
 
+#include <lib/clock.hpp>
+
 #include <memory>
 #include <string>
+#include <cstdint>
+#include <algorithm>
+
+#define ROUTINE_MAX_REQUIREMENTS 63 // Subsystems past this many can not be required and never conflict, the last bit is reserved
 
 namespace garage {
     class Robot;
     namespace lib {
         class Subsystem;
+
+        /**
+         * One bit per subsystem, given out in the order they are added to the robot
+         */
+        using RequirementMask=uint64_t;
+
+        /**
+         * Taken by requiring a subsystem that is disabled in the configuration. It carries over to any routine that runs
+         * this one, and the routine manager refuses to start them, so routines never have to check for a missing subsystem.
+         */
+        constexpr RequirementMask k_MissingSubsystemRequirement = RequirementMask(1) << ROUTINE_MAX_REQUIREMENTS;
+
+        class RoutineQueue;
+
+        class TimerWheel;
+
         class Routine {
+            friend class RoutineQueue;
+
+            friend class TimerWheel;
+
+        public:
+            /**
+             * Higher priorities start first and interrupt lower ones holding a subsystem they need
+             */
+            enum class Priority {
+                k_Low = 0, k_Normal = 1, k_High = 2
+            };
+
         protected:
             std::shared_ptr<Robot> m_Robot;
+            std::shared_ptr<Clock> m_Clock;
             std::string m_Name;
             bool m_IsFinished = true;
+            RequirementMask m_Requirements = 0;
+            bool m_IsQueued = false;
+            Priority m_Priority = Priority::k_Normal;
+            bool m_IsSleeping = false;
+            Clock::TimePoint m_WakeTime = Clock::TimePoint::max();
+            RequirementMask m_WakeEvents = 0;
+            // Links for the timer wheel it sleeps in
+            Routine* m_NextTimer = nullptr;
+            Routine* m_PreviousTimer = nullptr;
+            int64_t m_WakeTick = 0;
+            bool m_IsInTimerWheel = false;
+            // Zero when the current run is not being traced
+            uint32_t m_TraceRunId = 0;
+
+            /**
+             * The routine manager will not run two routines requiring the same subsystem at once
+             */
+            void AddRequirement(const std::shared_ptr<Subsystem>& subsystem);
 
             virtual void Update() {}
 
             virtual bool CheckFinished() { return true; }
 
+            /**
+             * Promises nothing will happen until the wake time or until one of the subsystems in the events signals,
+             * whichever is first, so the routine manager can skip updating it until then. Only lasts until the next
+             * update, and updating it early still has to work since whoever runs it might not be keeping track.
+             */
+            void SleepUntil(Clock::TimePoint wakeTime, RequirementMask wakeEvents = 0) {
+                m_IsSleeping = true;
+                m_WakeTime = wakeTime;
+                m_WakeEvents = wakeEvents;
+            }
+
+            void SleepUntilEvent(RequirementMask wakeEvents) {
+                SleepUntil(Clock::TimePoint::max(), wakeEvents);
+            }
+
+            /**
+             * For routines that run others, sleeps until the first of the children wakes if all of the ones still
+             * running are asleep. Takes anything that iterates over pointers to routines.
+             */
+            template<typename TIterator>
+            void SleepWithChildren(TIterator begin, TIterator end) {
+                Clock::TimePoint wakeTime = Clock::TimePoint::max();
+                RequirementMask wakeEvents = 0;
+                bool isAnySleeping = false;
+                for (; begin != end; ++begin) {
+                    Routine& child = **begin;
+                    if (child.IsFinished()) continue;
+                    if (!child.m_IsSleeping) return;
+                    wakeTime = std::min(wakeTime, child.m_WakeTime);
+                    wakeEvents |= child.m_WakeEvents;
+                    isAnySleeping = true;
+                }
+                if (isAnySleeping) SleepUntil(wakeTime, wakeEvents);
+            }
+
         public:
             Routine(std::shared_ptr<Robot>& robot, const std::string& name);
 
@@ -28,13 +116,55 @@ namespace garage {
 
             virtual bool Periodic();
 
-            virtual bool ShouldTerminateBasedOnUnlock(std::shared_ptr<Subsystem> subsystem) {
-                return true;
+            /**
+             * Called instead of terminating when a higher priority routine takes one of its subsystems.
+             * Has to leave the subsystems it held unlocked, which terminating already does.
+             */
+            virtual void Interrupt() {
+                Terminate();
             }
 
+            virtual bool ShouldTerminateBasedOnUnlock(const Subsystem& subsystem);
+
             virtual bool IsFinished() {
                 return m_IsFinished;
             }
+
+            const std::string& GetName() const {
+                return m_Name;
+            }
+
+            Priority GetPriority() const {
+                return m_Priority;
+            }
+
+            void SetPriority(Priority priority) {
+                m_Priority = priority;
+            }
+
+            bool IsSleeping() const {
+                return m_IsSleeping;
+            }
+
+            Clock::TimePoint GetWakeTime() const {
+                return m_WakeTime;
+            }
+
+            RequirementMask GetWakeEvents() const {
+                return m_WakeEvents;
+            }
+
+            bool IsQueued() const {
+                return m_IsQueued;
+            }
+
+            RequirementMask GetRequirements() const {
+                return m_Requirements;
+            }
+
+            bool IsMissingSubsystem() const {
+                return (m_Requirements & k_MissingSubsystemRequirement) != 0;
+            }
         };
     }
 }
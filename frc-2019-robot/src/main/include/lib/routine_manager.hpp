@@ -2,37 +2,111 @@
 
 #include <command.hpp>
 
+#include <lib/clock.hpp>
 #include <lib/routine.hpp>
+#include <lib/timer_wheel.hpp>
+#include <lib/routine_queue.hpp>
 
-#include <deque>
+#include <atomic>
 #include <memory>
+#include <vector>
 #include <utility>
 
 namespace garage {
     class Robot;
     namespace lib {
+        /**
+         * Runs every routine whose required subsystems are free at the same time. A routine that needs a subsystem
+         * already in use interrupts the routines holding it if they all have a lower priority, otherwise it waits.
+         * Waiting routines start by priority then in the order they were added, and never take a subsystem that one
+         * ahead of them is waiting on. Active routines that are asleep are parked in a timer wheel or on the events
+         * they wait for and are not looked at again until they are due.
+         */
         class RoutineManager {
         protected:
             std::shared_ptr<Robot> m_Robot;
-            std::deque<std::shared_ptr<Routine>> m_QueuedRoutines;
-            std::shared_ptr<Routine> m_ActiveRoutine;
+            RoutineQueue m_QueuedRoutines;
+            std::vector<std::shared_ptr<Routine>> m_ActiveRoutines;
+            std::vector<Clock::TimePoint> m_ActiveRoutineStartTimes;
+            // The active routines that are not parked, owned by the vector above
+            std::vector<Routine*> m_AwakeRoutines;
+            std::vector<Routine*> m_EventRoutines;
+            TimerWheel m_TimerWheel;
+            // Subsystems may signal from worker threads while they update
+            std::atomic<RequirementMask> m_PendingEvents{0};
+            std::shared_ptr<Clock> m_Clock;
+            RequirementMask m_ActiveRequirements = 0;
+            // The queue is only looked through again once something was added or finished
+            bool m_ShouldStartQueued = false;
+
+            void StartQueuedRoutines();
+
+            void RemoveActiveRoutine(std::size_t index);
+
+            std::size_t GetActiveIndex(const Routine& routine) const;
+
+            /**
+             * @return False if it is already due or has nothing to wait for, then it stays awake
+             */
+            bool Park(Routine& routine);
+
+            void Unpark(Routine& routine);
+
+            void WakeRoutine(Routine& routine);
+
+            void WakeDueRoutines(Clock::TimePoint now);
+
+            void UpdateActiveRequirements();
+
+            bool IsActive(const std::shared_ptr<Routine>& routine) const;
+
+            /**
+             * True when every active routine holding one of its subsystems has a lower priority, or there are none
+             */
+            bool CanInterrupt(const Routine& routine) const;
 
         public:
             RoutineManager(std::shared_ptr<Robot>& robot);
 
-            void AddRoutine(std::shared_ptr<Routine> routine);
-
-            void AddRoutinesFromCommand(Command& command);
+            /**
+             * Queues the routine, it starts on the next update at the earliest
+             */
+            void AddRoutine(const std::shared_ptr<Routine>& routine);
 
             void Reset();
 
             void Update();
 
-            std::weak_ptr<Routine> GetActiveRoutine();
+            /**
+             * Oldest first
+             */
+            const std::vector<std::shared_ptr<Routine>>& GetActiveRoutines() const {
+                return m_ActiveRoutines;
+            }
+
+            RequirementMask GetActiveRequirements() const {
+                return m_ActiveRequirements;
+            }
+
+            /**
+             * Called when a subsystem is taken back by the drivers, terminates the routines that were using it
+             */
+            void TerminateRoutinesBasedOnUnlock(const Subsystem& subsystem);
+
+            /**
+             * Wakes the routines sleeping on any of these subsystems on the next update
+             */
+            void SignalEvents(RequirementMask events) {
+                m_PendingEvents.fetch_or(events, std::memory_order_relaxed);
+            }
+
+            std::size_t GetParkedRoutineCount() const {
+                return m_ActiveRoutines.size() - m_AwakeRoutines.size();
+            }
 
             void TerminateAllRoutines();
 
-            void TerminateActiveRoutine();
+            void TerminateActiveRoutines();
         };
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <lib/logger.hpp>
+#include <lib/routine.hpp>
+
+#include <array>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Fixed set of routines of one type built up front, handed out again and again with new parameters instead of
+         * building a new tree for every request. The routine type has to have a Rebind taking those parameters.
+         * A routine is in use for as long as anything other than the pool holds on to it, such as the routine manager
+         * or a command, so acquiring never takes one that is queued or running.
+         */
+        template<typename TRoutine, std::size_t Capacity>
+        class RoutinePool {
+            static_assert(Capacity > 0, "Needs at least one routine");
+
+        protected:
+            std::array<std::shared_ptr<TRoutine>, Capacity> m_Routines;
+
+        public:
+            /**
+             * Every routine is built with the same arguments, they only matter until the first rebind
+             */
+            template<typename... TArguments>
+            explicit RoutinePool(TArguments&& ... arguments) {
+                for (auto& routine : m_Routines) {
+                    routine = std::make_shared<TRoutine>(arguments...);
+                }
+            }
+
+            RoutinePool(const RoutinePool&) = delete;
+
+            RoutinePool& operator=(const RoutinePool&) = delete;
+
+            /**
+             * Rebinds a routine that is not in use and hands it out, null if all of them are
+             */
+            template<typename... TArguments>
+            std::shared_ptr<TRoutine> Acquire(TArguments&& ... arguments) {
+                for (auto& routine : m_Routines) {
+                    if (routine.use_count() == 1) {
+                        routine->Rebind(std::forward<TArguments>(arguments)...);
+                        return routine;
+                    }
+                }
+                Logger::Log(Logger::LogLevel::k_Error, "[{}] All {} pooled routines are in use", m_Routines.front()->GetName(), Capacity);
+                return nullptr;
+            }
+
+            std::size_t GetAvailableCount() const {
+                std::size_t count = 0;
+                for (auto& routine : m_Routines) {
+                    if (routine.use_count() == 1) count++;
+                }
+                return count;
+            }
+
+            /**
+             * Every routine, in use or not
+             */
+            const std::array<std::shared_ptr<TRoutine>, Capacity>& GetRoutines() const {
+                return m_Routines;
+            }
+        };
+    }
+}
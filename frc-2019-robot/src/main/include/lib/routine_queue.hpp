@@ -0,0 +1,112 @@
+#pragma once
+
+#include <lib/routine.hpp>
+
+#include <array>
+#include <memory>
+#include <cstddef>
+
+#define ROUTINE_QUEUE_CAPACITY 64 // Routines waiting at once, far more than the drivers can ask for before any start
+
+namespace garage {
+    namespace lib {
+        /**
+         * Fixed capacity ring of routines waiting to start, highest priority first and in the order they were pushed
+         * within a priority. Membership is a flag on the routine itself, so rejecting a duplicate, pushing and clearing
+         * never search or touch the heap. A routine can only wait in one queue at a time.
+         */
+        class RoutineQueue {
+            static_assert(ROUTINE_QUEUE_CAPACITY > 1 && (ROUTINE_QUEUE_CAPACITY & (ROUTINE_QUEUE_CAPACITY - 1)) == 0,
+                          "Capacity must be a power of two");
+
+        protected:
+            static constexpr std::size_t k_Mask = ROUTINE_QUEUE_CAPACITY - 1;
+
+            std::array<std::shared_ptr<Routine>, ROUTINE_QUEUE_CAPACITY> m_Entries;
+            std::size_t m_Head = 0, m_Size = 0;
+
+            std::shared_ptr<Routine>& At(std::size_t index) {
+                return m_Entries[(m_Head + index) & k_Mask];
+            }
+
+        public:
+            RoutineQueue() = default;
+
+            RoutineQueue(const RoutineQueue&) = delete;
+
+            RoutineQueue& operator=(const RoutineQueue&) = delete;
+
+            ~RoutineQueue() {
+                Clear();
+            }
+
+            /**
+             * Goes behind everything of the same or higher priority, only lower priority routines have to move back
+             *
+             * @return False if the routine is already waiting or the queue is full
+             */
+            bool Push(const std::shared_ptr<Routine>& routine) {
+                if (routine->m_IsQueued || m_Size == ROUTINE_QUEUE_CAPACITY) return false;
+                routine->m_IsQueued = true;
+                std::size_t index = m_Size++;
+                for (; index > 0 && At(index - 1)->m_Priority < routine->m_Priority; index--) {
+                    At(index) = std::move(At(index - 1));
+                }
+                At(index) = routine;
+                return true;
+            }
+
+            bool IsFull() const {
+                return m_Size == ROUTINE_QUEUE_CAPACITY;
+            }
+
+            bool IsEmpty() const {
+                return m_Size == 0;
+            }
+
+            std::size_t GetSize() const {
+                return m_Size;
+            }
+
+            /**
+             * Takes the oldest routine out, the queue must not be empty
+             */
+            std::shared_ptr<Routine> Pop() {
+                std::shared_ptr<Routine> routine = std::move(At(0));
+                routine->m_IsQueued = false;
+                m_Head = (m_Head + 1) & k_Mask;
+                m_Size--;
+                return routine;
+            }
+
+            /**
+             * Calls the function on every entry oldest first and removes the ones it returns true for,
+             * the rest keep their order
+             */
+            template<typename TPredicate>
+            void RemoveIf(TPredicate&& predicate) {
+                std::size_t kept = 0;
+                for (std::size_t i = 0; i < m_Size; i++) {
+                    std::shared_ptr<Routine>& entry = At(i);
+                    if (predicate(entry)) {
+                        entry->m_IsQueued = false;
+                        entry.reset();
+                    } else {
+                        if (kept != i) At(kept) = std::move(entry);
+                        kept++;
+                    }
+                }
+                m_Size = kept;
+            }
+
+            void Clear() {
+                for (std::size_t i = 0; i < m_Size; i++) {
+                    std::shared_ptr<Routine>& entry = At(i);
+                    entry->m_IsQueued = false;
+                    entry.reset();
+                }
+                m_Head = m_Size = 0;
+            }
+        };
+    }
+}
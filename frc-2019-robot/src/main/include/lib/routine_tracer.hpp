@@ -0,0 +1,69 @@
+#pragma once
+
+#include <lib/clock.hpp>
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+#define ROUTINE_TRACE_CAPACITY 32768 // Events between exports, must be a power of two, more are dropped and counted
+#define ROUTINE_TRACE_NAME_SIZE 40 // Characters including the terminator, longer names are truncated
+
+namespace garage {
+    namespace lib {
+        /**
+         * Records when routines start, update and end into a lock-free queue, by the robot clock, and writes them out
+         * as a Chrome trace that chrome://tracing or ui.perfetto.dev can open. Every run of a routine is a span from
+         * start to finish or terminate, and every update is a slice nested inside whatever updated it, from the routine
+         * manager down through sequential and parallel routines. Recording only copies into the queue, the file is
+         * written when exporting, which should be somewhere the loop timing does not matter like disabled.
+         */
+        class RoutineTracer {
+        public:
+            enum class EventType : uint8_t {
+                k_Start, k_Update, k_Finish, k_Terminate
+            };
+
+        protected:
+            static std::atomic<bool> s_IsEnabled;
+            static std::atomic<uint32_t> s_NextRunId;
+            static std::atomic<unsigned long> s_DroppedEvents;
+
+        public:
+            static bool IsEnabled() {
+                return s_IsEnabled.load(std::memory_order_relaxed);
+            }
+
+            static void SetEnabled(bool isEnabled) {
+                s_IsEnabled = isEnabled;
+            }
+
+            /**
+             * Identifies one run of a routine from its start to its end, never zero
+             */
+            static uint32_t NextRunId() {
+                return s_NextRunId.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            /**
+             * Updates are recorded once they return with how long they took, the rest are instants
+             */
+            static void Record(EventType type, const std::string& name, uint32_t runId, Clock::TimePoint time,
+                               Clock::Duration duration = Clock::Duration::zero());
+
+            /**
+             * Writes everything recorded since the last export as a Chrome trace and empties the queue
+             */
+            static bool Export(const std::string& path);
+
+            /**
+             * Drops everything recorded so far
+             */
+            static void Clear();
+
+            static unsigned long GetDroppedCount() {
+                return s_DroppedEvents.load(std::memory_order_relaxed);
+            }
+        };
+    }
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <command.hpp>
+
+#include <lib/subsystem.hpp>
+#include <lib/subsystem_controller.hpp>
+
+#include <wpi/optional.h>
+
+#include <tuple>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+namespace garage {
+    namespace lib {
+        template<typename TController, typename... TControllers>
+        struct ControllerIndex;
+
+        template<typename TController, typename... TControllers>
+        struct ControllerIndex<TController, TController, TControllers...> : std::integral_constant<std::size_t, 0> {};
+
+        template<typename TController, typename TOther, typename... TControllers>
+        struct ControllerIndex<TController, TOther, TControllers...>
+                : std::integral_constant<std::size_t, 1 + ControllerIndex<TController, TControllers...>::value> {};
+
+        /**
+         * Subsystem with a closed set of controllers known at compile time, such as
+         * StaticControllableSubsystem<Elevator, RawElevatorController, SetPointElevatorController>. The controllers are held
+         * by value inside of the subsystem and the active one is an index, so running it is a chain of comparisons and a
+         * direct call instead of a pointer to follow and a virtual call. Locking, unlocking and resetting behave the same
+         * as ControllableSubsystem.
+         */
+        template<typename TSubsystem, typename... TControllers>
+        class StaticControllableSubsystem : public Subsystem {
+            static_assert(sizeof...(TControllers) > 0, "Needs at least one controller");
+
+        protected:
+            using Controllers=std::tuple<TControllers...>;
+
+            static constexpr std::size_t k_NoController = sizeof...(TControllers);
+
+            // Built after the subsystem since every controller keeps a reference to it
+            wpi::optional<Controllers> m_Controllers;
+            std::size_t m_ControllerIndex = k_NoController, m_UnlockedControllerIndex = k_NoController, m_ResetControllerIndex = k_NoController;
+            int m_ControlPhase;
+
+            template<typename TController>
+            static constexpr std::size_t IndexOf() {
+                return ControllerIndex<TController, TControllers...>::value;
+            }
+
+            template<typename TController>
+            static TSubsystem& ForController(TSubsystem& subsystem) {
+                return subsystem;
+            }
+
+            /* Qualified calls resolve to the override of the exact controller type without going through the vtable */
+
+            template<typename TController>
+            static void ControlController(TController& controller) {
+                controller.TController::Control();
+            }
+
+            template<typename TController>
+            static void ProcessCommandWithController(TController& controller, const Command& command) {
+                controller.TController::ProcessCommand(command);
+            }
+
+            template<typename TController>
+            static void ResetController(TController& controller) {
+                controller.TController::Reset();
+            }
+
+            /**
+             * Calls the function with the controller at a runtime index, nothing if there is not one
+             */
+            template<std::size_t Index = 0, typename TFunction>
+            typename std::enable_if<Index < k_NoController>::type VisitController(std::size_t index, TFunction&& function) {
+                if (index == Index)
+                    function(std::get<Index>(*m_Controllers));
+                else
+                    VisitController<Index + 1>(index, std::forward<TFunction>(function));
+            }
+
+            template<std::size_t Index = 0, typename TFunction>
+            typename std::enable_if<Index == k_NoController>::type VisitController(std::size_t, TFunction&&) {}
+
+            template<std::size_t... Indices>
+            void ResetControllers(std::index_sequence<Indices...>) {
+                using Expander = int[];
+                (void) Expander{0, (ResetController(std::get<Indices>(*m_Controllers)), 0)...};
+            }
+
+            /**
+             * Has to happen before any controller is used, such as at the start of OnPostInitialize
+             */
+            void CreateControllers() {
+                auto& subsystem = static_cast<TSubsystem&>(*this);
+                m_Controllers.emplace(ForController<TControllers>(subsystem)...);
+            }
+
+            template<typename TController>
+            TController& GetController() {
+                return std::get<TController>(*m_Controllers);
+            }
+
+            template<typename TController>
+            bool IsController() const {
+                return m_ControllerIndex == IndexOf<TController>();
+            }
+
+            const char* GetControllerName(std::size_t index) {
+                const char* name = "None";
+                VisitController(index, [&name](auto& controller) { name = controller.GetName().c_str(); });
+                return name;
+            }
+
+            bool SetController(std::size_t index) {
+                const bool different = index != m_ControllerIndex;
+                if (different) {
+                    if (index != m_UnlockedControllerIndex) {
+                        Lock();
+                    }
+                    VisitController(m_ControllerIndex, [](auto& controller) { controller.OnDisable(); });
+                    m_ControllerIndex = index;
+                    const char* name = GetControllerName(m_ControllerIndex);
+                    Log(Logger::LogLevel::k_Info, "Setting controller to: {}", name);
+                    m_NetworkTable->PutString("Controller", name);
+                    VisitController(m_ControllerIndex, [](auto& controller) { controller.OnEnable(); });
+                }
+                return different;
+            }
+
+            template<typename TController>
+            bool SetController() {
+                return SetController(IndexOf<TController>());
+            }
+
+            template<typename TController>
+            void SetUnlockedController() {
+                const std::size_t index = IndexOf<TController>();
+                if (index != m_UnlockedControllerIndex) {
+                    m_UnlockedControllerIndex = index;
+                    // If we are unlocked and received this update, set to the new mode
+                    if (!m_IsLocked && index != m_ControllerIndex) {
+                        SetController(index);
+                    }
+                }
+            }
+
+            template<typename TController>
+            void SetResetController() {
+                m_ResetControllerIndex = IndexOf<TController>();
+            }
+
+            void UpdateUnlocked(const Command& command) override {
+                if (m_ControllerIndex != k_NoController) {
+                    VisitController(m_ControllerIndex, [&command](auto& controller) { ProcessCommandWithController(controller, command); });
+                } else {
+                    LogSample(lib::Logger::LogLevel::k_Warning, "No controller detected");
+                }
+            }
+
+            void ResetUnlock() override {
+                if (m_ResetControllerIndex != k_NoController) {
+                    SetController(m_ResetControllerIndex);
+                } else {
+                    Subsystem::ResetUnlock();
+                }
+            }
+
+            /**
+             * Runs the active controller, timed as its own phase inside of Update
+             */
+            void RunController() {
+                if (m_ControllerIndex != k_NoController) {
+                    ProfilerScope controlScope(m_Profiler, m_ControlPhase);
+                    VisitController(m_ControllerIndex, [](auto& controller) { ControlController(controller); });
+                } else {
+                    LogSample(lib::Logger::LogLevel::k_Warning, "No controller detected");
+                }
+            }
+
+        public:
+            StaticControllableSubsystem(std::shared_ptr<Robot>& robot, const std::string& subsystemName)
+                    : Subsystem(robot, subsystemName), m_ControlPhase(m_Profiler.AddPhase(subsystemName + " Control")) {}
+
+            void Reset() override {
+                Subsystem::Reset();
+                if (m_Controllers) {
+                    ResetControllers(std::index_sequence_for<TControllers...>());
+                }
+            }
+
+            void Unlock() override {
+                Subsystem::Unlock();
+                SetController(m_UnlockedControllerIndex);
+            }
+
+            void RecordTelemetry(FlightRecorder& recorder, SubsystemTelemetry& telemetry) override {
+                Subsystem::RecordTelemetry(recorder, telemetry);
+                telemetry.controller = FLIGHT_RECORDER_NO_NAME;
+                VisitController(m_ControllerIndex, [&](auto& controller) {
+                    telemetry.controller = recorder.Intern(&controller, controller.GetName());
+                });
+            }
+        };
+    }
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <lib/routine.hpp>
+#include <lib/wait_routine.hpp>
+
+#include <array>
+#include <tuple>
+#include <memory>
+#include <string>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Routine trees with a shape known at compile time, such as Seq<Par<SetElevator, SetFlipper>, Wait<500>, LockServo>.
+         * Children are held by value inside their parent so the whole tree is one object, and every call into a child is
+         * qualified with its exact type so there is no virtual dispatch or pointer to follow. The behavior matches
+         * SequentialRoutine and ParallelRoutine, and the tree is a Routine that can be queued like any other.
+         */
+        template<typename... TChildren>
+        class StaticMultiRoutine : public Routine {
+            static_assert(sizeof...(TChildren) > 0, "Needs at least one child");
+
+        protected:
+            using Children=std::tuple<TChildren...>;
+            using Indices=std::index_sequence_for<TChildren...>;
+
+            template<std::size_t Index>
+            using Child=typename std::tuple_element<Index, Children>::type;
+
+            static constexpr std::size_t k_ChildCount = sizeof...(TChildren);
+
+            Children m_Children;
+
+            template<std::size_t Index>
+            Child<Index>& Get() {
+                return std::get<Index>(m_Children);
+            }
+
+            template<std::size_t... Indices>
+            std::array<Routine*, k_ChildCount> GetChildren(std::index_sequence<Indices...>) {
+                return {{&Get<Indices>()...}};
+            }
+
+            /* Qualified calls resolve to the override of the exact child type without going through the vtable */
+
+            template<typename TRoutine>
+            static void StartChild(TRoutine& routine) {
+                routine.TRoutine::Start();
+            }
+
+            template<typename TRoutine>
+            static bool PeriodicChild(TRoutine& routine) {
+                return routine.TRoutine::Periodic();
+            }
+
+            template<typename TRoutine>
+            static void TerminateChild(TRoutine& routine) {
+                routine.TRoutine::Terminate();
+            }
+
+            template<typename TRoutine>
+            static bool IsChildFinished(TRoutine& routine) {
+                return routine.TRoutine::IsFinished();
+            }
+
+            template<std::size_t... Indices>
+            void AddChildRequirements(std::index_sequence<Indices...>) {
+                using Expander = int[];
+                (void) Expander{0, (m_Requirements |= Get<Indices>().GetRequirements(), 0)...};
+            }
+
+            /* Runtime index to a child, compiles down to a chain of comparisons with direct calls */
+
+            template<std::size_t Index = 0>
+            typename std::enable_if<Index < k_ChildCount>::type StartAt(std::size_t index) {
+                if (index == Index) StartChild(Get<Index>()); else StartAt<Index + 1>(index);
+            }
+
+            template<std::size_t Index = 0>
+            typename std::enable_if<Index == k_ChildCount>::type StartAt(std::size_t) {}
+
+            template<std::size_t Index = 0>
+            typename std::enable_if<Index < k_ChildCount, bool>::type PeriodicAt(std::size_t index) {
+                return index == Index ? PeriodicChild(Get<Index>()) : PeriodicAt<Index + 1>(index);
+            }
+
+            template<std::size_t Index = 0>
+            typename std::enable_if<Index == k_ChildCount, bool>::type PeriodicAt(std::size_t) {
+                return true;
+            }
+
+            template<std::size_t Index = 0>
+            typename std::enable_if<Index < k_ChildCount>::type TerminateAt(std::size_t index) {
+                if (index == Index) TerminateChild(Get<Index>()); else TerminateAt<Index + 1>(index);
+            }
+
+            template<std::size_t Index = 0>
+            typename std::enable_if<Index == k_ChildCount>::type TerminateAt(std::size_t) {}
+
+        public:
+            template<typename... TArguments>
+            StaticMultiRoutine(std::shared_ptr<Robot>& robot, const std::string& name, TArguments&& ... children)
+                    : Routine(robot, name), m_Children(std::forward<TArguments>(children)...) {
+                AddChildRequirements(Indices());
+            }
+        };
+
+        /**
+         * Runs the children one after the other
+         */
+        template<typename... TChildren>
+        class Seq : public StaticMultiRoutine<TChildren...> {
+            using Base=StaticMultiRoutine<TChildren...>;
+
+        protected:
+            std::size_t m_CurrentIndex = 0;
+
+            void Update() override {
+                if (m_CurrentIndex < Base::k_ChildCount) {
+                    if (this->PeriodicAt(m_CurrentIndex)) {
+                        m_CurrentIndex++;
+                        this->StartAt(m_CurrentIndex);
+                    } else {
+                        Routine* currentChild = this->GetChildren(typename Base::Indices())[m_CurrentIndex];
+                        this->SleepWithChildren(&currentChild, &currentChild + 1);
+                    }
+                }
+            }
+
+            bool CheckFinished() override {
+                return m_CurrentIndex >= Base::k_ChildCount;
+            }
+
+        public:
+            using Base::Base;
+
+            void Start() override {
+                Routine::Start();
+                m_CurrentIndex = 0;
+                this->StartAt(0);
+            }
+
+            void Terminate() override {
+                Routine::Terminate();
+                this->TerminateAt(m_CurrentIndex);
+            }
+        };
+
+        /**
+         * Runs the children at the same time, finishes once all of them have
+         */
+        template<typename... TChildren>
+        class Par : public StaticMultiRoutine<TChildren...> {
+            using Base=StaticMultiRoutine<TChildren...>;
+
+        protected:
+            template<std::size_t... Indices>
+            void StartAll(std::index_sequence<Indices...>) {
+                using Expander = int[];
+                (void) Expander{0, (Base::StartChild(this->template Get<Indices>()), 0)...};
+            }
+
+            template<std::size_t... Indices>
+            void PeriodicAll(std::index_sequence<Indices...>) {
+                using Expander = int[];
+                (void) Expander{0, (Base::PeriodicChild(this->template Get<Indices>()), 0)...};
+            }
+
+            template<std::size_t... Indices>
+            void TerminateAll(std::index_sequence<Indices...>) {
+                using Expander = int[];
+                (void) Expander{0, (Base::TerminateChild(this->template Get<Indices>()), 0)...};
+            }
+
+            template<std::size_t... Indices>
+            bool AreAllFinished(std::index_sequence<Indices...>) {
+                bool areAllFinished = true;
+                using Expander = int[];
+                (void) Expander{0, (areAllFinished &= Base::IsChildFinished(this->template Get<Indices>()), 0)...};
+                return areAllFinished;
+            }
+
+            void Update() override {
+                PeriodicAll(typename Base::Indices());
+                auto children = this->GetChildren(typename Base::Indices());
+                this->SleepWithChildren(children.begin(), children.end());
+            }
+
+            bool CheckFinished() override {
+                return AreAllFinished(typename Base::Indices());
+            }
+
+        public:
+            using Base::Base;
+
+            void Start() override {
+                Routine::Start();
+                StartAll(typename Base::Indices());
+            }
+
+            void Terminate() override {
+                Routine::Terminate();
+                TerminateAll(typename Base::Indices());
+            }
+        };
+
+        /**
+         * Wait routine with its duration in the type so it can go in a tree without arguments
+         */
+        template<long Milliseconds>
+        class Wait : public WaitRoutine {
+        public:
+            Wait(std::shared_ptr<Robot>& robot, const std::string& name = "Wait Routine") : WaitRoutine(robot, Milliseconds, name) {}
+        };
+    }
+}
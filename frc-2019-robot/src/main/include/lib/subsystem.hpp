@@ -3,9 +3,13 @@
 #include <command.hpp>
 
 #include <lib/logger.hpp>
+#include <lib/routine.hpp>
+#include <lib/loop_profiler.hpp>
+#include <lib/flight_recorder.hpp>
 
 #include <memory>
 #include <string>
+#include <vector>
 #include <functional>
 
 #include <networktables/NetworkTable.h>
@@ -20,22 +24,26 @@
 namespace garage {
     class Robot;
     namespace lib {
-        class Subsystem : public std::enable_shared_from_this<Subsystem> {
+        class Subsystem {
         protected:
             std::shared_ptr<Robot> m_Robot;
             std::shared_ptr<nt::NetworkTable> m_NetworkTable;
-            Command m_LastCommand = {};
+            LoopProfiler& m_Profiler;
+            int m_PeriodicPhase, m_SpacedUpdatePhase, m_UpdatePhase;
             bool m_IsLocked = false;
+            RequirementMask m_Requirement = 0;
             unsigned long m_SequenceNumber = 0;
-            std::string m_SubsystemName;
+            std::string m_SubsystemName, m_LogPrefix;
+            // Subsystems that have to finish their update before this one starts when they are updated in parallel
+            std::vector<const Subsystem*> m_Dependencies;
 
             virtual void AdvanceSequence();
 
-            virtual void SpacedUpdate(Command& command) {}
+            virtual void SpacedUpdate(const Command& command) {}
 
-            virtual bool ShouldUnlock(Command& command);
+            virtual bool ShouldUnlock(const Command& command);
 
-            virtual void UpdateUnlocked(Command& command) {}
+            virtual void UpdateUnlocked(const Command& command) {}
 
             virtual void UpdateLocked() {}
 
@@ -43,6 +51,11 @@ namespace garage {
 
             virtual void ResetUnlock();
 
+            /**
+             * Copies already read sensor values into the telemetry, this runs every loop so it should not talk to hardware
+             */
+            virtual void FillTelemetry(SubsystemTelemetry& telemetry) {}
+
             void AddNetworkTableListener(const std::string& entryName, const double defaultValue,
                                          std::function<bool(const double newValue)> callback);
 
@@ -57,10 +70,50 @@ namespace garage {
 
             void Periodic();
 
+            /**
+             * First part of Periodic, unlocks if the command takes over from the routines holding this subsystem and terminates
+             * them. Routines can touch other subsystems when they end, so this always runs on the main thread.
+             */
+            void CheckUnlock();
+
+            /**
+             * Rest of Periodic, only touches this subsystem so it can run alongside other subsystems
+             */
+            void RunPeriodic();
+
             void Log(Logger::LogLevel logLevel, const std::string& log);
 
+            template<typename... TArgs>
+            void Log(Logger::LogLevel logLevel, const char* format, const TArgs& ... arguments) {
+                Logger::LogWithPrefix(logLevel, m_LogPrefix, format, arguments...);
+            }
+
+            /**
+             * Only logs every so often, takes a string since a number after a format would be read as an argument
+             */
             void LogSample(Logger::LogLevel logLevel, const std::string& log, int frequency = DEFAULT_FREQUENCY);
 
+            template<typename... TArgs>
+            void LogSample(Logger::LogLevel logLevel, const char* format, const TArgs& ... arguments) {
+                if (Logger::IsEnabled(logLevel) && m_SequenceNumber % DEFAULT_FREQUENCY == 0)
+                    Log(logLevel, format, arguments...);
+            }
+
+            virtual void RecordTelemetry(FlightRecorder& recorder, SubsystemTelemetry& telemetry);
+
+            const std::string& GetName() const {
+                return m_SubsystemName;
+            }
+
+            const std::string& GetLogPrefix() const {
+                return m_LogPrefix;
+            }
+
+            /**
+             * Wakes the routines sleeping until this subsystem does something, such as reaching a set point
+             */
+            void SignalEvent();
+
             virtual void Lock();
 
             virtual void Unlock();
@@ -68,6 +121,29 @@ namespace garage {
             bool IsLocked() {
                 return m_IsLocked;
             }
+
+            /**
+             * Bit routines add to their requirements, zero if the robot ran out of bits
+             */
+            RequirementMask GetRequirement() const {
+                return m_Requirement;
+            }
+
+            void SetRequirement(RequirementMask requirement) {
+                m_Requirement = requirement;
+            }
+
+            /**
+             * Declares that this subsystem reads or writes the other one while it updates, so they are never updated at the same time
+             * and the other one goes first
+             */
+            void AddDependency(const Subsystem& subsystem) {
+                m_Dependencies.push_back(&subsystem);
+            }
+
+            const std::vector<const Subsystem*>& GetDependencies() const {
+                return m_Dependencies;
+            }
         };
     }
 }
@@ -12,18 +12,28 @@ namespace garage {
         template<typename TSubsystem>
         class SubsystemController {
         protected:
-            std::weak_ptr<TSubsystem> m_Subsystem;
+            // Owned by the subsystem, which is owned by the robot, so it is always there
+            TSubsystem& m_Subsystem;
             std::string m_Name;
 
         public:
-            SubsystemController(std::weak_ptr<TSubsystem>& subsystem, const std::string& name)
+            SubsystemController(TSubsystem& subsystem, const std::string& name)
                     : m_Subsystem(subsystem), m_Name(name) {
 //                static_assert(std::is_base_of<Subsystem, TSubsystem>::value, "Must be a subsystem");
             };
 
-            void Log(Logger::LogLevel logLevel, const std::string& log) {
-                auto subsystem = std::dynamic_pointer_cast<Subsystem>(m_Subsystem.lock());
-                subsystem->Log(logLevel, Logger::Format("[%s] %s", FMT_STR(m_Name), FMT_STR(log)));
+            template<typename... TArgs>
+            void Log(Logger::LogLevel logLevel, const char* format, const TArgs& ... arguments) {
+                if (!Logger::IsEnabled(logLevel)) return;
+                // Compose both prefixes and the message in the thread buffer in one pass
+                auto& buffer = Logger::GetThreadBuffer();
+                buffer.Clear();
+                buffer.Append(m_Subsystem.GetLogPrefix());
+                buffer.Append('[');
+                buffer.Append(m_Name);
+                buffer.Append("] ");
+                buffer.Format(format, arguments...);
+                Logger::Log(logLevel, buffer);
             }
 
             virtual void OnEnable() {
@@ -37,7 +47,7 @@ namespace garage {
 
             virtual void Reset() {}
 
-            virtual void ProcessCommand(Command& command) {}
+            virtual void ProcessCommand(const Command& command) {}
 
             virtual void Control() {}
 
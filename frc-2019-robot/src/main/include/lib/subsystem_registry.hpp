@@ -0,0 +1,95 @@
+#pragma once
+
+#include <lib/logger.hpp>
+#include <lib/routine.hpp>
+#include <lib/subsystem.hpp>
+
+#include <tuple>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Subsystems of the robot from a list of types, such as SubsystemRegistry<Drive, Elevator, Flipper>. Each one has its
+         * own slot so looking one up is resolved at compile time, and asking for a type not in the list does not compile.
+         * Slots of subsystems disabled in the configuration stay empty. Subsystems only known at run time can still be added,
+         * and run after the typed ones.
+         */
+        template<typename... TSubsystems>
+        class SubsystemRegistry {
+        protected:
+            using Indices=std::index_sequence_for<TSubsystems...>;
+
+            std::tuple<std::shared_ptr<TSubsystems>...> m_Subsystems;
+            std::vector<std::shared_ptr<Subsystem>> m_AddedSubsystems;
+            // Every enabled subsystem in the order they were added, which is also the order of their requirement bits
+            std::vector<std::shared_ptr<Subsystem>> m_AllSubsystems;
+
+            template<typename TFunction, std::size_t... Indices>
+            void ForEachTyped(TFunction& function, std::index_sequence<Indices...>) {
+                using Expander = int[];
+                (void) Expander{0, (std::get<Indices>(m_Subsystems) ? function(*std::get<Indices>(m_Subsystems)) : void(), 0)...};
+            }
+
+        public:
+            /**
+             * Has to be called once for each enabled subsystem, its requirement bit is given out here
+             */
+            void Add(const std::shared_ptr<Subsystem>& subsystem) {
+                if (m_AllSubsystems.size() < ROUTINE_MAX_REQUIREMENTS) {
+                    subsystem->SetRequirement(RequirementMask(1) << m_AllSubsystems.size());
+                } else {
+                    subsystem->Log(Logger::LogLevel::k_Warning, "No requirement bits left, routines using it will not wait for each other");
+                }
+                m_AllSubsystems.push_back(subsystem);
+                subsystem->PostInitialize();
+            }
+
+            template<typename TSubsystem, typename... TArguments>
+            void Create(TArguments&& ... arguments) {
+                auto& subsystem = std::get<std::shared_ptr<TSubsystem>>(m_Subsystems);
+                subsystem = std::make_shared<TSubsystem>(std::forward<TArguments>(arguments)...);
+                Add(subsystem);
+            }
+
+            /**
+             * For subsystems that are not part of the type list
+             */
+            void AddDynamic(const std::shared_ptr<Subsystem>& subsystem) {
+                m_AddedSubsystems.push_back(subsystem);
+                Add(subsystem);
+            }
+
+            /**
+             * Empty when it is disabled. Routines can require it anyway, see k_MissingSubsystemRequirement.
+             */
+            template<typename TSubsystem>
+            const std::shared_ptr<TSubsystem>& Get() const {
+                return std::get<std::shared_ptr<TSubsystem>>(m_Subsystems);
+            }
+
+            template<typename TSubsystem>
+            bool IsEnabled() const {
+                return static_cast<bool>(Get<TSubsystem>());
+            }
+
+            /**
+             * Calls the function with each enabled subsystem as its exact type, then with the added ones as a Subsystem
+             */
+            template<typename TFunction>
+            void ForEach(TFunction&& function) {
+                ForEachTyped(function, Indices());
+                for (const auto& subsystem : m_AddedSubsystems) {
+                    function(*subsystem);
+                }
+            }
+
+            const std::vector<std::shared_ptr<Subsystem>>& GetAll() const {
+                return m_AllSubsystems;
+            }
+        };
+    }
+}
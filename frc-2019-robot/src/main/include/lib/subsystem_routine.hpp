@@ -14,10 +14,8 @@ namespace garage {
 
         public:
             SubsystemRoutine(std::shared_ptr<Robot> robot, const std::string& name)
-                : Routine(robot, name), m_Subsystem(robot->GetSubsystem<TSubsystem>()) { }
-
-            bool ShouldTerminateBasedOnUnlock(std::shared_ptr<Subsystem> subsystem) override {
-                return subsystem == m_Subsystem;
+                : Routine(robot, name), m_Subsystem(robot->GetSubsystem<TSubsystem>()) {
+                AddRequirement(m_Subsystem);
             }
         };
     }
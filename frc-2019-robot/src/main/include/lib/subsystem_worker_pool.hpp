@@ -0,0 +1,83 @@
+#pragma once
+
+#include <lib/subsystem.hpp>
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <condition_variable>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Updates subsystems at the same time on a fixed set of threads, each pinned to its own core, so time spent waiting
+         * on the CAN bus in one subsystem overlaps with the others. The thread calling Run works through the subsystems too
+         * and returns once all of them are done, which is the barrier at the end of the loop. A subsystem only starts once
+         * the subsystems it declared a dependency on have finished, otherwise they are taken in the order they were given.
+         */
+        class SubsystemWorkerPool {
+        protected:
+            struct Job {
+                Subsystem* subsystem;
+                // Indices of jobs that have to finish first, always earlier in the order
+                std::vector<std::size_t> dependencies;
+            };
+
+            std::vector<Job> m_Jobs;
+            std::unique_ptr<std::atomic<bool>[]> m_IsJobDone;
+            std::vector<std::thread> m_Workers;
+            std::mutex m_Mutex;
+            std::condition_variable m_StartCondition, m_DoneCondition;
+            unsigned long m_Generation = 0;
+            bool m_ShouldStop = false;
+            std::atomic<std::size_t> m_NextJob{0}, m_RemainingJobs{0};
+
+            /**
+             * Orders the subsystems so each comes after its dependencies, false if they depend on each other in a cycle
+             */
+            bool CreateJobs(const std::vector<std::shared_ptr<Subsystem>>& subsystems);
+
+            /**
+             * @param generation Run the worker was started after, it waits for the one after that
+             */
+            void RunWorker(int core, unsigned long generation);
+
+            /**
+             * Takes jobs until there are none left to take
+             */
+            void RunJobs();
+
+        public:
+            SubsystemWorkerPool() = default;
+
+            SubsystemWorkerPool(const SubsystemWorkerPool&) = delete;
+
+            SubsystemWorkerPool& operator=(const SubsystemWorkerPool&) = delete;
+
+            ~SubsystemWorkerPool() {
+                Stop();
+            }
+
+            /**
+             * Starts the worker threads, the subsystems can not change until it is stopped
+             *
+             * @return False if the dependencies have a cycle, then nothing is started
+             */
+            bool Start(const std::vector<std::shared_ptr<Subsystem>>& subsystems, int workerCount);
+
+            void Stop();
+
+            bool IsRunning() const {
+                return !m_Jobs.empty();
+            }
+
+            /**
+             * Updates every subsystem, except for checking if they should unlock which has to be done before
+             */
+            void Run();
+        };
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <lib/routine.hpp>
+
+#include <chrono>
+#include <memory>
+
+namespace garage {
+    namespace lib {
+        /**
+         * Runs a routine for at most the timeout. If it has not finished by then it is terminated and the fallback
+         * routine runs in its place, or with no fallback it counts as finished, so a mechanism stuck just short of its
+         * tolerance does not hold up the rest of a sequence.
+         */
+        class TimeoutRoutine : public Routine {
+        protected:
+            std::shared_ptr<Routine> m_Routine, m_FallbackRoutine;
+            std::chrono::milliseconds m_TimeoutMilliseconds;
+            Clock::TimePoint m_EndTime;
+            bool m_IsTimedOut = false;
+
+            void Update() override;
+
+            bool CheckFinished() override;
+
+        public:
+            TimeoutRoutine(std::shared_ptr<Robot> robot, const std::shared_ptr<Routine>& routine, long timeoutMilliseconds,
+                           const std::shared_ptr<Routine>& fallbackRoutine = nullptr, const std::string& name = "Timeout Routine");
+
+            void Start() override;
+
+            void Terminate() override;
+
+            bool IsTimedOut() const {
+                return m_IsTimedOut;
+            }
+        };
+    }
+}
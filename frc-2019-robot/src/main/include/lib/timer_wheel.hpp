@@ -0,0 +1,130 @@
+#pragma once
+
+#include <lib/clock.hpp>
+#include <lib/routine.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#define TIMER_WHEEL_SLOTS 1024 // One lap is a little over five seconds, longer sleeps go around more than once
+#define TIMER_WHEEL_RESOLUTION 5 // Milliseconds, a few ticks per loop so a wake is never more than a loop late
+
+namespace garage {
+    namespace lib {
+        /**
+         * Sleeping routines bucketed by the tick they wake on. Each slot is a list threaded through the routines
+         * themselves, so scheduling and cancelling are constant time and never touch the heap, and advancing only
+         * looks at the slots for the ticks that passed. Routines are woken on the tick their wake time falls in,
+         * which can be a little early, so they should check their time again when they run.
+         */
+        class TimerWheel {
+            static_assert(TIMER_WHEEL_SLOTS > 1 && (TIMER_WHEEL_SLOTS & (TIMER_WHEEL_SLOTS - 1)) == 0,
+                          "Slots must be a power of two");
+
+        protected:
+            static constexpr std::size_t k_Mask = TIMER_WHEEL_SLOTS - 1;
+
+            std::array<Routine*, TIMER_WHEEL_SLOTS> m_Slots{};
+            int64_t m_CurrentTick = 0;
+            std::size_t m_Size = 0;
+
+            static int64_t GetTick(Clock::TimePoint time) {
+                return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() / TIMER_WHEEL_RESOLUTION;
+            }
+
+            void Unlink(Routine& routine) {
+                if (routine.m_PreviousTimer)
+                    routine.m_PreviousTimer->m_NextTimer = routine.m_NextTimer;
+                else
+                    m_Slots[routine.m_WakeTick & k_Mask] = routine.m_NextTimer;
+                if (routine.m_NextTimer) routine.m_NextTimer->m_PreviousTimer = routine.m_PreviousTimer;
+                routine.m_NextTimer = routine.m_PreviousTimer = nullptr;
+                routine.m_IsInTimerWheel = false;
+                m_Size--;
+            }
+
+        public:
+            TimerWheel() = default;
+
+            TimerWheel(const TimerWheel&) = delete;
+
+            TimerWheel& operator=(const TimerWheel&) = delete;
+
+            ~TimerWheel() {
+                Clear();
+            }
+
+            /**
+             * Starts counting ticks from now, only while nothing is scheduled
+             */
+            void Reset(Clock::TimePoint now) {
+                Clear();
+                m_CurrentTick = GetTick(now);
+            }
+
+            /**
+             * @return False if the tick for the wake time already passed, the routine should stay awake
+             */
+            bool Schedule(Routine& routine, Clock::TimePoint wakeTime) {
+                const int64_t wakeTick = GetTick(wakeTime);
+                if (wakeTick <= m_CurrentTick) return false;
+                if (routine.m_IsInTimerWheel) Unlink(routine);
+                Routine*& head = m_Slots[wakeTick & k_Mask];
+                routine.m_WakeTick = wakeTick;
+                routine.m_PreviousTimer = nullptr;
+                routine.m_NextTimer = head;
+                if (head) head->m_PreviousTimer = &routine;
+                head = &routine;
+                routine.m_IsInTimerWheel = true;
+                m_Size++;
+                return true;
+            }
+
+            void Cancel(Routine& routine) {
+                if (routine.m_IsInTimerWheel) Unlink(routine);
+            }
+
+            /**
+             * Calls the function with every routine whose tick is up to now and takes them out
+             */
+            template<typename TFunction>
+            void Advance(Clock::TimePoint now, TFunction&& wake) {
+                const int64_t nowTick = GetTick(now);
+                if (nowTick <= m_CurrentTick) return;
+                if (m_Size > 0) {
+                    // Past a full lap every slot has been passed once
+                    const int64_t lastTick = nowTick - m_CurrentTick > TIMER_WHEEL_SLOTS ? m_CurrentTick + TIMER_WHEEL_SLOTS : nowTick;
+                    for (int64_t tick = m_CurrentTick + 1; tick <= lastTick && m_Size > 0; tick++) {
+                        Routine* routine = m_Slots[tick & k_Mask];
+                        while (routine) {
+                            Routine* next = routine->m_NextTimer;
+                            // Ones further out share the slot until their lap comes around
+                            if (routine->m_WakeTick <= nowTick) {
+                                Unlink(*routine);
+                                wake(*routine);
+                            }
+                            routine = next;
+                        }
+                    }
+                }
+                m_CurrentTick = nowTick;
+            }
+
+            bool IsEmpty() const {
+                return m_Size == 0;
+            }
+
+            std::size_t GetSize() const {
+                return m_Size;
+            }
+
+            void Clear() {
+                for (auto& head : m_Slots) {
+                    while (head) Unlink(*head);
+                }
+            }
+        };
+    }
+}
@@ -8,7 +8,7 @@ namespace garage {
     namespace lib {
         class WaitRoutine : public Routine {
         protected:
-            std::chrono::system_clock::time_point m_StartTime, m_EndTime;
+            Clock::TimePoint m_StartTime, m_EndTime;
             std::chrono::milliseconds m_DurationMilliseconds;
 
             bool CheckFinished() override;
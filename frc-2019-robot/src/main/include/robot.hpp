@@ -9,11 +9,18 @@
 #include <subsystem/ball_intake.hpp>
 #include <subsystem/hatch_intake.hpp>
 
+#include <lib/clock.hpp>
 #include <lib/logger.hpp>
 #include <lib/routine.hpp>
 #include <lib/subsystem.hpp>
 #include <lib/limelight.hpp>
+#include <lib/command_log.hpp>
+#include <lib/routine_pool.hpp>
+#include <lib/loop_profiler.hpp>
+#include <lib/flight_recorder.hpp>
 #include <lib/routine_manager.hpp>
+#include <lib/subsystem_registry.hpp>
+#include <lib/subsystem_worker_pool.hpp>
 
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableInstance.h>
@@ -25,12 +32,22 @@
 
 #include <wpi/optional.h>
 
+#include <array>
 #include <chrono>
 #include <memory>
+#include <string>
+#include <cstddef>
 
 namespace garage {
+    class ClimbHabRoutine;
+
+    class BallIntakeRoutine;
+
     class Robot : public frc::TimedRobot {
     public:
+        // Created in this order, which is the order their requirement bits are given out and they are updated in
+        using Subsystems=lib::SubsystemRegistry<Elevator, Drive, Flipper, BallIntake, HatchIntake, Outrigger>;
+
         enum class LedMode {
             k_Idle = 0, k_NoTarget = 1, k_HasTarget = 2, k_BallIntake = 3, k_Climb = 4
         };
@@ -41,21 +58,24 @@ namespace garage {
         std::shared_ptr<nt::NetworkTable> m_NetworkTable, m_DashboardNetworkTable;
         frc::XboxController m_PrimaryController{0}, m_SecondaryController{1};
         frc::Joystick m_ButtonBoard{2};
-        Command m_Command;
+        // This loop's command and the last one's, swapped by index instead of copied
+        std::array<Command, 2> m_Commands{};
+        std::size_t m_CommandIndex = 0;
+        RoutineRequests m_RoutineRequests;
         std::shared_ptr<lib::RoutineManager> m_RoutineManager;
-        std::shared_ptr<Drive> m_Drive;
-        std::shared_ptr<Flipper> m_Flipper;
-        std::shared_ptr<Elevator> m_Elevator;
-        std::shared_ptr<Outrigger> m_Outrigger;
-        std::shared_ptr<BallIntake> m_BallIntake;
-        std::shared_ptr<HatchIntake> m_HatchIntake;
-        std::vector<std::shared_ptr<lib::Subsystem>> m_Subsystems;
-        wpi::optional<std::chrono::system_clock::time_point> m_LastPeriodicTime;
-        wpi::optional<std::chrono::system_clock::time_point> m_EndRumble;
+        Subsystems m_Subsystems;
+        lib::SubsystemWorkerPool m_SubsystemWorkers;
+        std::shared_ptr<lib::Clock> m_Clock = std::make_shared<lib::SteadyClock>();
+        wpi::optional<lib::Clock::TimePoint> m_LastPeriodicTime;
+        wpi::optional<lib::Clock::TimePoint> m_EndRumble;
         RobotConfig m_Config;
         frc::I2C m_LedModule{frc::I2C::Port::kOnboard, 1};
         LedMode m_LedMode;
         lib::Limelight m_LimeLight;
+        lib::FlightRecorder m_FlightRecorder;
+        lib::CommandLog m_CommandLog;
+        lib::LoopProfiler m_Profiler;
+        int m_LoopPhase, m_UpdateCommandPhase, m_RoutineManagerPhase, m_SubsystemsPhase, m_FlightRecorderPhase;
         std::chrono::milliseconds m_Period;
         // Routines
 //        std::shared_ptr<test::TestDriveAutoRoutine> m_DriveForwardRoutine;
@@ -64,9 +84,29 @@ namespace garage {
         // ==== Reset
                 m_ResetWithServoRoutine,
         // ==== Utility
-                m_GroundBallIntakeRoutine, m_LoadingBallIntakeRoutine, m_PostHatchPlacementRoutine, m_StowFlipperRoutine,
+                m_PostHatchPlacementRoutine, m_StowFlipperRoutine,
         // ==== End game
-                m_EndGameRoutine, m_SecondLevelClimbRoutine, m_ThirdLevelClimbRoutine;
+                m_EndGameRoutine;
+        // One routine each, rebound to the height asked for, since they all use the elevator and can not run at once
+        std::shared_ptr<lib::RoutinePool<BallIntakeRoutine, 1>> m_BallIntakeRoutines;
+        std::shared_ptr<lib::RoutinePool<ClimbHabRoutine, 1>> m_ClimbHabRoutines;
+        std::vector<std::string> m_CommandRoutineNames;
+
+        void CheckLoopTime();
+
+        /**
+         * Path for a new recording in the directory, numbered one past the newest recording there. Older ones are
+         * deleted so only the newest keep count are left, counting the new one.
+         */
+        static std::string CreateRecordingPath(const std::string& directory, const std::string& prefix, const char* extension,
+                                               unsigned int keepCount);
+
+        /**
+         * Rest of the loop once the command is known, the same whether it came from the controllers or a replay
+         */
+        void RunCommand();
+
+        void UpdateSubsystems();
 
     public:
         void RobotInit() override;
@@ -89,12 +129,39 @@ namespace garage {
 
         void TeleopPeriodic() override;
 
+        /**
+         * Stops updating subsystems in parallel until it is set again, since the workers only know the subsystems they started with
+         */
         void AddSubsystem(std::shared_ptr<lib::Subsystem> subsystem);
 
+        /**
+         * Starts or stops the subsystem workers, falls back to updating one after the other if they can not be started
+         */
+        void SetParallelSubsystems(bool isParallel);
+
+        void OpenFlightRecorder();
+
+        void OpenCommandLog();
+
+        void ExportRoutineTrace();
+
+        /**
+         * Reads the controllers into the command without acting on anything
+         */
         void UpdateCommand();
 
+        /**
+         * Acts on the parts of the command that do not go through subsystem controllers or routines
+         */
+        void ExecuteCommand();
+
         void ControllablePeriodic();
 
+        /**
+         * Runs a loop with a recorded command instead of reading the controllers
+         */
+        void ReplayPeriodic(const Command& command, const RoutineRequests& routines);
+
         void SetLedMode(LedMode ledMode);
 
         bool ShouldOutput() const {
@@ -102,7 +169,7 @@ namespace garage {
         }
 
         void RumbleControllers() {
-            m_EndRumble = std::chrono::system_clock::now() + std::chrono::milliseconds(200);
+            m_EndRumble = m_Clock->Now() + std::chrono::milliseconds(200);
             SetControllerRumbles(0.4);
         }
 
@@ -118,47 +185,76 @@ namespace garage {
             return m_Config;
         }
 
+        /**
+         * Replaces the steady clock, such as with a simulated one. Has to happen before initialization
+         * since routines and the routine manager keep the clock they were created with.
+         */
+        void SetClock(std::shared_ptr<lib::Clock> clock) {
+            m_Clock = clock;
+        }
+
+        std::shared_ptr<lib::Clock> GetClock() const {
+            return m_Clock;
+        }
+
+        lib::LoopProfiler& GetProfiler() {
+            return m_Profiler;
+        }
+
         lib::Limelight& GetLimelight() {
             return m_LimeLight;
         }
 
-        Command GetLatestCommand() {
-            return m_Command;
+        /**
+         * Stays the same for the whole loop, so it can be held by reference until the next command is read
+         */
+        const Command& GetLatestCommand() const {
+            return m_Commands[m_CommandIndex];
+        }
+
+        const Command& GetPreviousCommand() const {
+            return m_Commands[m_CommandIndex ^ 1];
         }
 
+        const RoutineRequests& GetRoutineRequests() const {
+            return m_RoutineRequests;
+        }
+
+        /**
+         * Empty if it is disabled in the configuration
+         */
         template<typename TSubsystem>
-        std::shared_ptr<TSubsystem> GetSubsystem() {
-            return nullptr;
+        const std::shared_ptr<TSubsystem>& GetSubsystem() const {
+            return m_Subsystems.Get<TSubsystem>();
+        }
+
+        Subsystems& GetSubsystems() {
+            return m_Subsystems;
         }
 
         std::shared_ptr<NetworkTable> GetNetworkTable() const {
             return m_NetworkTable;
         }
 
-        std::shared_ptr<lib::RoutineManager> GetRoutineManager() {
-            return m_RoutineManager;
+        lib::RoutineManager& GetRoutineManager() {
+            return *m_RoutineManager;
+        }
+
+        /**
+         * The routine to start for a request. Shared routines are rebound to the parameters of the request if they are
+         * free, otherwise they are returned as they are so asking again while one runs queues it again like before.
+         */
+        std::shared_ptr<lib::Routine> GetCommandRoutine(CommandRoutine routine);
+
+        /**
+         * Name of each command routine by its value, which the command log keeps to check a replay uses the same ones
+         */
+        const std::vector<std::string>& GetCommandRoutineNames() const {
+            return m_CommandRoutineNames;
         }
 
         void TestInit() override;
 
         void TestPeriodic() override;
     };
-
-    template<>
-    std::shared_ptr<Elevator> Robot::GetSubsystem();
-
-    template<>
-    std::shared_ptr<Drive> Robot::GetSubsystem();
-
-    template<>
-    std::shared_ptr<Flipper> Robot::GetSubsystem();
-
-    template<>
-    std::shared_ptr<BallIntake> Robot::GetSubsystem();
-
-    template<>
-    std::shared_ptr<Outrigger> Robot::GetSubsystem();
-
-    template<>
-    std::shared_ptr<HatchIntake> Robot::GetSubsystem();
 }
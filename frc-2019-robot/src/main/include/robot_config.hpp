@@ -7,6 +7,18 @@ namespace garage {
         lib::Logger::LogLevel logLevel = lib::Logger::LogLevel::k_Info;
         bool
                 shouldOutput = true,
+        // Write log lines from a background thread so bursts do not stall the control loop
+                asyncLogging = true,
+        // Binary record of every control loop, see FlightRecorderDecoder
+                enableFlightRecorder = true,
+        // Record the command of every loop so a match can be replayed, see CommandReplay
+                enableCommandLog = true,
+        // Trace every routine start, update and end, written as a Chrome trace each time the robot is disabled
+                enableRoutineTracer = false,
+        // Time each phase of the control loop and publish percentiles under Profiler
+                enableProfiler = true,
+        // Update subsystems at the same time on worker threads, see SubsystemWorkerPool
+                enableParallelSubsystems = false,
         // Subsystems
                 enableElevator = true,
                 enableDrive = true,
@@ -14,6 +26,14 @@ namespace garage {
                 enableBallIntake = true,
                 enableHatchIntake = true,
                 enableOutrigger = false;
+        // Threads besides the loop one, the roboRIO has two cores
+        int subsystemWorkerCount = 1;
+        // Every boot makes a new file, only this many of the newest are kept so they do not fill up the flash
+        unsigned int flightRecorderFileCount = 8;
+        const char* flightRecorderDirectory = "/home/lvuser/flight_recorder";
+        unsigned int commandLogFileCount = 8;
+        const char* commandLogDirectory = "/home/lvuser/command_log";
+        const char* routineTraceDirectory = "/home/lvuser/routine_trace";
         double bottomHatchHeight = 5.0,
         /* Rocket */
         // ==== Ball
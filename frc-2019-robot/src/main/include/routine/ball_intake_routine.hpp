@@ -8,6 +8,8 @@
 
 #include <memory>
 
+#define BALL_INTAKE_SET_POINT_TIMEOUT 2000 // Milliseconds, intake anyway if the elevator or flipper stops just short
+
 namespace garage {
     class BallIntake;
 
@@ -24,9 +26,16 @@ namespace garage {
     };
 
     class BallIntakeRoutine : public lib::SequentialRoutine {
+    protected:
+        std::shared_ptr<ElevatorAndFlipperRoutine> m_ElevatorAndFlipperRoutine;
+
     public:
         BallIntakeRoutine(std::shared_ptr<Robot> robot, double setPoint, double angle);
 
+        void Rebind(double setPoint, double angle) {
+            m_ElevatorAndFlipperRoutine->Rebind(setPoint, angle);
+        }
+
         void Start() override;
 
         void Terminate() override;
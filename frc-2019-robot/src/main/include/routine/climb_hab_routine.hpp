@@ -1,5 +1,7 @@
 #pragma once
 
+#include <routine/set_elevator_position_routine.hpp>
+
 #include <lib/subsystem_routine.hpp>
 #include <lib/sequential_routine.hpp>
 
@@ -41,10 +43,23 @@ namespace garage {
         void Start() override;
 
         void Terminate() override;
+
+        void Rebind(double height) {
+            m_Height = height;
+        }
     };
 
     class ClimbHabRoutine : public lib::SequentialRoutine {
+    protected:
+        std::shared_ptr<SetElevatorPositionRoutine> m_SetElevatorPositionRoutine;
+        std::shared_ptr<MainClimbRoutine> m_MainClimbRoutine;
+
     public:
         ClimbHabRoutine(std::shared_ptr<Robot>& robot, double height);
+
+        void Rebind(double height) {
+            m_SetElevatorPositionRoutine->Rebind(height + CLIMB_INITIAL_GAP_HEIGHT);
+            m_MainClimbRoutine->Rebind(height);
+        }
     };
 }
\ No newline at end of file
@@ -1,20 +1,22 @@
 #pragma once
 
-#include <lib/parallel_routine.hpp>
+#include <lib/static_routine.hpp>
 
 #include <routine/set_flipper_angle_routine.hpp>
 #include <routine/set_elevator_position_routine.hpp>
 
 namespace garage {
-    class ElevatorAndFlipperRoutine : public lib::ParallelRoutine {
+    class ElevatorAndFlipperRoutine : public lib::Par<SetElevatorPositionRoutine, SetFlipperAngleRoutine> {
     public:
         ElevatorAndFlipperRoutine(std::shared_ptr<Robot> robot, double setPoint, double angle,
                                   const std::string& name = "Elevator And Flipper Routine")
-                : ParallelRoutine(robot, name, {
-                std::make_shared<SetElevatorPositionRoutine>(robot, setPoint),
-                std::make_shared<SetFlipperAngleRoutine>(robot, angle)
-        }) {
+                : Par(robot, name, SetElevatorPositionRoutine(robot, setPoint), SetFlipperAngleRoutine(robot, angle)) {
 
         }
+
+        void Rebind(double setPoint, double angle) {
+            Get<0>().Rebind(setPoint);
+            Get<1>().Rebind(angle);
+        }
     };
 }
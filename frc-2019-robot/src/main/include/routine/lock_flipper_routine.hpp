@@ -3,19 +3,29 @@
 #include <routine/set_flipper_servo_routine.hpp>
 #include <routine/set_flipper_angle_routine.hpp>
 
-#include <lib/wait_routine.hpp>
-#include <lib/sequential_routine.hpp>
+#include <lib/coroutine_routine.hpp>
 
 namespace garage {
-    class LockFlipperRoutine : public lib::SequentialRoutine {
-    public:
-        LockFlipperRoutine(std::shared_ptr<Robot> robot) : SequentialRoutine(robot, "Lock Flipper", {
-                std::make_shared<SetFlipperAngleRoutine>(robot, FLIPPER_UPPER_ANGLE),
-                std::make_shared<lib::WaitRoutine>(robot, 500l),
-                std::make_shared<SetFlipperServoRoutine>(robot, true),
-                std::make_shared<lib::WaitRoutine>(robot, 2000l)
-        }) {
+    class LockFlipperRoutine : public lib::CoroutineRoutine {
+    protected:
+        std::shared_ptr<lib::Routine> m_SetAngleRoutine, m_LockServoRoutine;
+
+        bool Run() override {
+            ROUTINE_BEGIN();
+            ROUTINE_AWAIT_ALL(m_SetAngleRoutine);
+            ROUTINE_WAIT(500);
+            ROUTINE_AWAIT_ALL(m_LockServoRoutine);
+            ROUTINE_WAIT(2000);
+            ROUTINE_END();
+        }
 
+    public:
+        LockFlipperRoutine(std::shared_ptr<Robot> robot)
+                : CoroutineRoutine(robot, "Lock Flipper"),
+                  m_SetAngleRoutine(std::make_shared<SetFlipperAngleRoutine>(robot, FLIPPER_UPPER_ANGLE)),
+                  m_LockServoRoutine(std::make_shared<SetFlipperServoRoutine>(robot, true)) {
+            AddRequirements(m_SetAngleRoutine);
+            AddRequirements(m_LockServoRoutine);
         }
     };
-}
\ No newline at end of file
+}
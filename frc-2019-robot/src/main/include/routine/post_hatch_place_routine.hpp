@@ -1,18 +1,26 @@
 #pragma once
 
-#include <lib/sequential_routine.hpp>
+#include <lib/coroutine_routine.hpp>
+
+#define POST_HATCH_PLACE_OPEN_TIME 600 // Milliseconds for the intake to let go before backing away
+#define POST_HATCH_PLACE_BACK_OUT_TIME 800 // Milliseconds
+#define POST_HATCH_PLACE_BACK_OUT_OUTPUT -0.08 // Percent output
 
 namespace garage {
-    class PostHatchPlaceRoutine : public lib::SequentialRoutine {
-    public:
-        PostHatchPlaceRoutine(std::shared_ptr<Robot> robot);
-    };
+    class Drive;
+
+    class HatchIntake;
+
+    class PostHatchPlaceRoutine : public lib::CoroutineRoutine {
+    protected:
+        std::shared_ptr<Drive> m_Drive;
+        std::shared_ptr<HatchIntake> m_HatchIntake;
+
+        bool Run() override;
 
-    class OpenHatchIntakeRoutine : public lib::Routine {
     public:
-        OpenHatchIntakeRoutine(std::shared_ptr<Robot> robot);
+        PostHatchPlaceRoutine(std::shared_ptr<Robot> robot);
 
-    private:
-        void Start() override;
+        void Terminate() override;
     };
-}
\ No newline at end of file
+}
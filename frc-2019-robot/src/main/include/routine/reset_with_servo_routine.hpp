@@ -1,20 +1,20 @@
 #pragma once
 
-#include <lib/wait_routine.hpp>
+#include <lib/static_routine.hpp>
 
-#include <routine/reset_routine.hpp>
 #include <routine/set_flipper_servo_routine.hpp>
+#include <routine/set_flipper_angle_routine.hpp>
+#include <routine/set_elevator_position_routine.hpp>
 
 namespace garage {
-    class ResetWithServoRoutine : public ResetRoutine {
+    /**
+     * Reset that also unlocks the flipper servo, everything runs at once so the waits only hold it open for the servo
+     */
+    class ResetWithServoRoutine : public lib::Par<SetElevatorPositionRoutine, SetFlipperAngleRoutine,
+            lib::Wait<500>, SetFlipperServoRoutine, lib::Wait<2000>> {
     public:
         ResetWithServoRoutine(std::shared_ptr<Robot> robot)
-                : ResetRoutine(robot) {
-            m_SubRoutines.insert(m_SubRoutines.end(), {
-                    std::make_shared<lib::WaitRoutine>(robot, 500l),
-                    std::make_shared<SetFlipperServoRoutine>(robot, false),
-                    std::make_shared<lib::WaitRoutine>(robot, 2000l)
-            });
-        }
+                : Par(robot, "Reset", SetElevatorPositionRoutine(robot, ELEVATOR_MIN), SetFlipperAngleRoutine(robot, FLIPPER_LOWER),
+                      lib::Wait<500>(robot), SetFlipperServoRoutine(robot, false), lib::Wait<2000>(robot)) {}
     };
-}
\ No newline at end of file
+}
@@ -19,5 +19,12 @@ namespace garage {
         void Start() override;
 
         void Terminate() override;
+
+        /**
+         * Only while it is not running, see lib::RoutinePool
+         */
+        void Rebind(double setPoint) {
+            m_SetPoint = setPoint;
+        }
     };
 }
\ No newline at end of file
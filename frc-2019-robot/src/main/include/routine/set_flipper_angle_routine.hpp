@@ -15,6 +15,10 @@ namespace garage {
 
         void Terminate() override;
 
+        void Rebind(double angle) {
+            m_Angle = angle;
+        }
+
     protected:
         bool CheckFinished() override;
     };
@@ -10,9 +10,9 @@ namespace garage {
     protected:
         bool m_ShouldLock = false;
 
-        void Start() override;
-
     public:
         SetFlipperServoRoutine(std::shared_ptr<Robot> robot, bool shouldLock, const std::string& name = "Set Flipper Servo");
+
+        void Start() override;
     };
 }
\ No newline at end of file
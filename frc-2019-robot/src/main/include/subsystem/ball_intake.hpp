@@ -3,8 +3,7 @@
 #include <hardware_map.hpp>
 
 #include <lib/subsystem.hpp>
-
-#include <ctre/phoenix/motorcontrol/can/TalonSRX.h>
+#include <lib/hardware/hardware.hpp>
 
 #define OUTPUT_PROPORTION_INTAKING 0.25
 #define OUTPUT_PROPORTION_EXPELLING 0.8
@@ -22,21 +21,23 @@ namespace garage {
 
     class BallIntake : public lib::Subsystem {
     protected:
-        ctre::phoenix::motorcontrol::can::TalonSRX m_RightIntake{BALL_INTAKE_MASTER}, m_LeftIntake{BALL_INTAKE_SLAVE};
-        double m_LastOpenLoopRamp = 0.0, m_LastOutput = 0.0;
+        lib::TalonSRX m_RightIntake{BALL_INTAKE_MASTER}, m_LeftIntake{BALL_INTAKE_SLAVE};
+        double m_LastOpenLoopRamp = 0.0, m_LastOutput = 0.0, m_Current = 0.0;
         int m_HasBallCount = 0;
 
         void SetOutput(double output);
 
         void ConfigOpenLoopRamp(double ramp);
 
-        void UpdateUnlocked(Command& command) override;
+        void UpdateUnlocked(const Command& command) override;
+
+        void SpacedUpdate(const Command& command) override;
 
-        void SpacedUpdate(Command& command) override;
+        void FillTelemetry(lib::SubsystemTelemetry& telemetry) override;
 
         void SetIntakeMode(IntakeMode intakeMode, double strength = 0.0);
 
-        bool ShouldUnlock(Command& command) override;
+        bool ShouldUnlock(const Command& command) override;
 
     public:
         BallIntake(std::shared_ptr<Robot>& robot);
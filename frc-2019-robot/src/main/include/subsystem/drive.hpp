@@ -4,13 +4,11 @@
 #include <hardware_map.hpp>
 
 #include <lib/limelight.hpp>
-#include <lib/controllable_subsystem.hpp>
+#include <lib/static_controllable_subsystem.hpp>
+#include <lib/hardware/hardware.hpp>
 
 #include <garage_math/garage_math.hpp>
 
-#include <rev/CANSparkMax.h>
-#include <ctre/phoenix/sensors/PigeonIMU.h>
-
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableInstance.h>
 
@@ -49,31 +47,31 @@ namespace garage {
     using DriveController=lib::SubsystemController<Drive>;
 
     class RawDriveController : public DriveController {
+    protected:
+        double m_LeftOutput = 0.0, m_RightOutput = 0.0;
+
     public:
-        RawDriveController(std::weak_ptr<Drive>& drive) : DriveController(drive, "Raw Drive Controller") {}
+        RawDriveController(Drive& drive) : DriveController(drive, "Raw Drive Controller") {}
 
         void SetDriveOutput(double leftOutput, double rightOutput) {
             m_LeftOutput = leftOutput;
             m_RightOutput = rightOutput;
         }
 
-    protected:
-        double m_LeftOutput = 0.0, m_RightOutput = 0.0;
-
         void Control() override;
 
         void Reset() override;
     };
 
     class ManualDriveController : public DriveController {
-    public:
-        ManualDriveController(std::weak_ptr<Drive>& drive) : DriveController(drive, "Manual Drive Controller") {}
-
     protected:
         double m_ForwardInput = 0.0, m_TurnInput = 0.0, m_OldTurnInput = 0.0, m_QuickStopAccumulator = 0.0, m_NegativeInertiaAccumulator = 0.0;
         bool m_IsQuickTurn = false;
 
-        void ProcessCommand(Command& command) override;
+    public:
+        ManualDriveController(Drive& drive) : DriveController(drive, "Manual Drive Controller") {}
+
+        void ProcessCommand(const Command& command) override;
 
         void Control() override;
 
@@ -81,16 +79,16 @@ namespace garage {
     };
 
     class AutoAlignDriveController : public DriveController {
-    public:
-        AutoAlignDriveController(std::weak_ptr<Drive>& drive);
-
     protected:
         lib::Limelight& m_Limelight;
 
+    public:
+        AutoAlignDriveController(Drive& drive);
+
         void Control() override;
     };
 
-    class Drive : public lib::ControllableSubsystem<Drive> {
+    class Drive : public lib::StaticControllableSubsystem<Drive, RawDriveController, ManualDriveController, AutoAlignDriveController> {
         friend class RawDriveController;
 
         friend class ManualDriveController;
@@ -99,23 +97,20 @@ namespace garage {
 
     protected:
         double m_LeftOutput = 0.0, m_RightOutput = 0.0;
-        double m_RightEncoderPosition = 0.0, m_LeftEncoderPosition = 0.0;
-        rev::CANSparkMax
-                m_RightMaster{DRIVE_RIGHT_MASTER, rev::CANSparkMax::MotorType::kBrushless},
-                m_LeftMaster{DRIVE_LEFT_MASTER, rev::CANSparkMax::MotorType::kBrushless},
-                m_RightSlave{DRIVE_RIGHT_SLAVE, rev::CANSparkMax::MotorType::kBrushless},
-                m_LeftSlave{DRIVE_LEFT_SLAVE, rev::CANSparkMax::MotorType::kBrushless};
-        rev::CANEncoder m_LeftEncoder = m_LeftMaster.GetEncoder(), m_RightEncoder = m_RightMaster.GetEncoder();
+        double m_RightEncoderPosition = 0.0, m_LeftEncoderPosition = 0.0, m_AppliedOutput = 0.0, m_Current = 0.0;
+        lib::SparkMax
+                m_RightMaster{DRIVE_RIGHT_MASTER}, m_LeftMaster{DRIVE_LEFT_MASTER},
+                m_RightSlave{DRIVE_RIGHT_SLAVE}, m_LeftSlave{DRIVE_LEFT_SLAVE};
+        lib::Encoder &m_LeftEncoder = m_LeftMaster.GetEncoder(), &m_RightEncoder = m_RightMaster.GetEncoder();
 //        ctre::phoenix::sensors::PigeonIMU m_Pigeon{PIGEON_IMU};
-        std::shared_ptr<RawDriveController> m_RawController;
-        std::shared_ptr<ManualDriveController> m_ManualController;
-        std::shared_ptr<AutoAlignDriveController> m_AutoAlignController;
 
-        void SpacedUpdate(Command& command) override;
+        void SpacedUpdate(const Command& command) override;
 
         void Update() override;
 
-        bool ShouldUnlock(Command& command) override;
+        bool ShouldUnlock(const Command& command) override;
+
+        void FillTelemetry(lib::SubsystemTelemetry& telemetry) override;
 
     public:
         Drive(std::shared_ptr<Robot>& robot);
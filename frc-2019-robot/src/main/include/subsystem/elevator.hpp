@@ -3,9 +3,8 @@
 #include <hardware_map.hpp>
 
 #include <lib/subsystem_controller.hpp>
-#include <lib/controllable_subsystem.hpp>
-
-#include <rev/CANSparkMax.h>
+#include <lib/static_controllable_subsystem.hpp>
+#include <lib/hardware/hardware.hpp>
 
 #define ELEVATOR_MAX 110.0 // Encoder ticks
 #define ELEVATOR_MIN 0.0 // Encoder ticks
@@ -66,14 +65,14 @@ namespace garage {
         double m_Output = 0.0;
 
     public:
-        RawElevatorController(std::weak_ptr<Elevator>& elevator)
+        RawElevatorController(Elevator& elevator)
                 : ElevatorController(elevator, "Raw Controller") {}
 
         void Reset() override {
             m_Output = 0.0;
         }
 
-        void ProcessCommand(Command& command) override;
+        void ProcessCommand(const Command& command) override;
 
         void Control() override;
 
@@ -87,10 +86,10 @@ namespace garage {
         double m_WantedSetPoint = 0;
 
     public:
-        SetPointElevatorController(std::weak_ptr<Elevator>& elevator)
+        SetPointElevatorController(Elevator& elevator)
                 : ElevatorController(elevator, "Set Point Controller") {}
 
-        void ProcessCommand(Command& command) override;
+        void ProcessCommand(const Command& command) override;
 
         void Control() override;
 
@@ -101,6 +100,10 @@ namespace garage {
         void SetWantedSetPoint(double wantedSetPoint) {
             m_WantedSetPoint = wantedSetPoint;
         }
+
+        double GetWantedSetPoint() const {
+            return m_WantedSetPoint;
+        }
     };
 
     class VelocityElevatorController : public ElevatorController {
@@ -108,10 +111,10 @@ namespace garage {
         double m_WantedVelocity = 0.0;
 
     public:
-        VelocityElevatorController(std::weak_ptr<Elevator>& elevator)
+        VelocityElevatorController(Elevator& elevator)
                 : ElevatorController(elevator, "Velocity Controller") {}
 
-        void ProcessCommand(Command& command) override;
+        void ProcessCommand(const Command& command) override;
 
         void Control() override;
 
@@ -122,26 +125,26 @@ namespace garage {
 
     class SoftLandElevatorController : public ElevatorController {
     public:
-        SoftLandElevatorController(std::weak_ptr<Elevator>& elevator)
+        SoftLandElevatorController(Elevator& elevator)
                 : ElevatorController(elevator, "Soft Land Controller") {}
 
         void Control() override;
     };
 
     class ClimbElevatorController : public ElevatorController {
-    protected:
+    public:
+        ClimbElevatorController(Elevator& elevator)
+                : ElevatorController(elevator, "Climb Elevator Controller") {}
+
         void Control() override;
 
         void Reset() override {
 
         }
-
-    public:
-        ClimbElevatorController(std::weak_ptr<Elevator>& elevator)
-                : ElevatorController(elevator, "Climb Elevator Controller") {}
     };
 
-    class Elevator : public lib::ControllableSubsystem<Elevator> {
+    class Elevator : public lib::StaticControllableSubsystem<Elevator,
+            RawElevatorController, SetPointElevatorController, VelocityElevatorController, SoftLandElevatorController, ClimbElevatorController> {
         friend class RawElevatorController;
 
         friend class SetPointElevatorController;
@@ -153,29 +156,23 @@ namespace garage {
         friend class ClimbElevatorController;
 
     protected:
-        double m_EncoderPosition = 0, m_EncoderVelocity = 0, m_FeedForward = ELEVATOR_FF, m_MaxVelocity = ELEVATOR_VELOCITY;
-        rev::CANSparkMax
-                m_SparkMaster{ELEVATOR_MASTER, rev::CANSparkMax::MotorType::kBrushless},
-                m_SparkSlave{ELEVATOR_SLAVE, rev::CANSparkMax::MotorType::kBrushless};
-        rev::CANPIDController m_SparkController = m_SparkMaster.GetPIDController();
-        rev::CANEncoder m_Encoder = m_SparkSlave.GetEncoder();
-        rev::CANDigitalInput m_ReverseLimitSwitch = m_SparkSlave.GetReverseLimitSwitch(rev::CANDigitalInput::LimitSwitchPolarity::kNormallyOpen);
-        bool m_IsFirstLimitSwitchHit = true;
-        std::shared_ptr<RawElevatorController> m_RawController;
-        std::shared_ptr<SetPointElevatorController> m_SetPointController;
-        std::shared_ptr<VelocityElevatorController> m_VelocityController;
-        std::shared_ptr<SoftLandElevatorController> m_SoftLandController;
-        std::shared_ptr<ClimbElevatorController> m_ClimbController;
+        double m_EncoderPosition = 0, m_EncoderVelocity = 0, m_Output = 0.0, m_Current = 0.0, m_FeedForward = ELEVATOR_FF, m_MaxVelocity = ELEVATOR_VELOCITY;
+        lib::SparkMax m_SparkMaster{ELEVATOR_MASTER}, m_SparkSlave{ELEVATOR_SLAVE};
+        lib::Encoder& m_Encoder = m_SparkSlave.GetEncoder();
+        lib::LimitSwitch& m_ReverseLimitSwitch = m_SparkSlave.GetReverseLimitSwitch();
+        bool m_IsFirstLimitSwitchHit = true, m_WasWithinSetPoint = false;
 
         void ConfigSpeedControllers();
 
         void SetupNetworkTableEntries();
 
-        bool ShouldUnlock(Command& command) override;
+        bool ShouldUnlock(const Command& command) override;
 
         void Update() override;
 
-        void SpacedUpdate(Command& command) override;
+        void SpacedUpdate(const Command& command) override;
+
+        void FillTelemetry(lib::SubsystemTelemetry& telemetry) override;
 
     public:
         Elevator(std::shared_ptr<Robot>& robot);
@@ -3,11 +3,8 @@
 #include <hardware_map.hpp>
 
 #include <lib/subsystem_controller.hpp>
-#include <lib/controllable_subsystem.hpp>
-
-#include <frc/Servo.h>
-
-#include <rev/CANSparkMax.h>
+#include <lib/static_controllable_subsystem.hpp>
+#include <lib/hardware/hardware.hpp>
 
 #define FLIPPER_LOWER 0.0 //  Raw encoder set point
 #define FLIPPER_UPPER 40.0 // Raw encoder set point
@@ -55,7 +52,7 @@ namespace garage {
 
     class FlipperController : public lib::SubsystemController<Flipper> {
     public:
-        FlipperController(std::weak_ptr<Flipper>& flipper, const std::string& name)
+        FlipperController(Flipper& flipper, const std::string& name)
                 : SubsystemController(flipper, name) {}
 
         virtual double GetWantedAngle();
@@ -66,7 +63,7 @@ namespace garage {
         double m_Output = 0.0;
 
     public:
-        RawFlipperController(std::weak_ptr<Flipper>& flipper)
+        RawFlipperController(Flipper& flipper)
                 : FlipperController(flipper, "Raw Controller") {}
 
         void Reset() override {
@@ -75,7 +72,7 @@ namespace garage {
 
         void SetOutput(double output);
 
-        void ProcessCommand(Command& command) override;
+        void ProcessCommand(const Command& command) override;
 
         void Control() override;
     };
@@ -85,7 +82,7 @@ namespace garage {
         double m_WantedVelocity = 0.0;
 
     public:
-        VelocityFlipperController(std::weak_ptr<Flipper>& flipper)
+        VelocityFlipperController(Flipper& flipper)
                 : FlipperController(flipper, "Velocity Controller") {}
 
         void SetWantedVelocity(double velocity) {
@@ -96,7 +93,7 @@ namespace garage {
             m_WantedVelocity = 0.0;
         }
 
-        void ProcessCommand(Command& command) override;
+        void ProcessCommand(const Command& command) override;
 
         void Control() override;
     };
@@ -106,7 +103,7 @@ namespace garage {
         double m_SetPoint = 0.0;
 
     public:
-        SetPointFlipperController(std::weak_ptr<Flipper>& flipper)
+        SetPointFlipperController(Flipper& flipper)
                 : FlipperController(flipper, "Set Point Controller") {}
 
         void SetSetPoint(double setPoint) {
@@ -117,14 +114,14 @@ namespace garage {
             m_SetPoint = 0.0;
         }
 
-        void ProcessCommand(Command& command) override;
+        void ProcessCommand(const Command& command) override;
 
         void Control() override;
 
         double GetWantedAngle() override;
     };
 
-    class Flipper : public lib::ControllableSubsystem<Flipper> {
+    class Flipper : public lib::StaticControllableSubsystem<Flipper, RawFlipperController, SetPointFlipperController, VelocityFlipperController> {
         friend class RawFlipperController;
 
         friend class VelocityFlipperController;
@@ -132,34 +129,32 @@ namespace garage {
         friend class SetPointFlipperController;
 
     protected:
-        rev::CANSparkMax m_FlipperMaster{FLIPPER, rev::CANSparkMax::MotorType::kBrushless};
-        rev::CANPIDController m_FlipperController = m_FlipperMaster.GetPIDController();
-        rev::CANEncoder m_Encoder = m_FlipperMaster.GetEncoder();
-        rev::CANDigitalInput
-                m_ForwardLimitSwitch = m_FlipperMaster.GetForwardLimitSwitch(rev::CANDigitalInput::LimitSwitchPolarity::kNormallyOpen),
-                m_ReverseLimitSwitch = m_FlipperMaster.GetReverseLimitSwitch(rev::CANDigitalInput::LimitSwitchPolarity::kNormallyOpen);
+        lib::SparkMax m_FlipperMaster{FLIPPER};
+        lib::Encoder& m_Encoder = m_FlipperMaster.GetEncoder();
+        lib::LimitSwitch
+                &m_ForwardLimitSwitch = m_FlipperMaster.GetForwardLimitSwitch(),
+                &m_ReverseLimitSwitch = m_FlipperMaster.GetReverseLimitSwitch();
         bool
                 m_IsForwardLimitSwitchDown = false, m_FirstForwardLimitSwitchHit = true,
                 m_IsReverseLimitSwitchDown = false, m_FirstReverseLimitSwitchHit = true;
-        double m_EncoderPosition = 0.0, m_EncoderVelocity = 0.0, m_Angle = 0.0;
+        double m_EncoderPosition = 0.0, m_EncoderVelocity = 0.0, m_Angle = 0.0, m_Output = 0.0, m_Current = 0.0;
         double m_AngleFeedForward = FLIPPER_ANGLE_FF, m_MaxVelocity = FLIPPER_VELOCITY;
-        std::shared_ptr<RawFlipperController> m_RawController;
-        std::shared_ptr<SetPointFlipperController> m_SetPointController;
-        std::shared_ptr<VelocityFlipperController> m_VelocityController;
-        frc::Servo m_CameraServo{CAMERA_SERVO}, m_LockServo{LOCK_SERVO};
+        lib::PwmServo m_CameraServo{CAMERA_SERVO}, m_LockServo{LOCK_SERVO};
         uint16_t m_CameraServoOutput = CAMERA_SERVO_LOWER, m_LockServoOutput = LOCK_SERVO_LOWER;
 
         void SetupNetworkTableValues();
 
         void Update() override;
 
-        void SpacedUpdate(Command& command) override;
+        void SpacedUpdate(const Command& command) override;
+
+        void FillTelemetry(lib::SubsystemTelemetry& telemetry) override;
 
-        bool ShouldUnlock(Command& command) override;
+        bool ShouldUnlock(const Command& command) override;
 
         bool IsWithinMotorOutputConditions(double wantedOutput, double forwardThreshold, double reverseThreshold);
 
-        void HandleLimitSwitch(rev::CANDigitalInput& limitSwitch, bool& isLimitSwitchDown, bool& isFirstHit, double resetEncoderValue);
+        void HandleLimitSwitch(lib::LimitSwitch& limitSwitch, bool& isLimitSwitchDown, bool& isFirstHit, double resetEncoderValue);
 
     public:
         Flipper(std::shared_ptr<Robot>& robot);
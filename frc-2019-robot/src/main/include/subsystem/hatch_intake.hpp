@@ -3,10 +3,7 @@
 #include <hardware_map.hpp>
 
 #include <lib/subsystem.hpp>
-
-#include <frc/Servo.h>
-
-#include <ctre/phoenix/motorcontrol/can/VictorSPX.h>
+#include <lib/hardware/hardware.hpp>
 
 #define HATCH_SERVO_LOWER 700
 #define HATCH_SERVO_UPPER 1700
@@ -16,13 +13,15 @@ namespace garage {
     protected:
         bool m_IntakeOpen = false;
         uint16_t m_ServoOutput = HATCH_SERVO_LOWER;
-        frc::Servo m_Servo{HATCH_SERVO};
+        lib::PwmServo m_Servo{HATCH_SERVO};
 
-        void UpdateUnlocked(Command& command) override;
+        void UpdateUnlocked(const Command& command) override;
 
         void Update() override;
 
-        bool ShouldUnlock(Command& command) override;
+        bool ShouldUnlock(const Command& command) override;
+
+        void FillTelemetry(lib::SubsystemTelemetry& telemetry) override;
 
     public:
         HatchIntake(std::shared_ptr<Robot>& robot);
@@ -2,9 +2,8 @@
 
 #include <hardware_map.hpp>
 
-#include <lib/controllable_subsystem.hpp>
-
-#include <rev/CANSparkMax.h>
+#include <lib/static_controllable_subsystem.hpp>
+#include <lib/hardware/hardware.hpp>
 
 #define OUTRIGGER_LOWER 0.0
 #define OUTRIGGER_UPPER 90.0
@@ -39,7 +38,7 @@ namespace garage {
         double m_SetPoint = OUTRIGGER_LOWER;
 
     public:
-        SetPointOutriggerController(std::weak_ptr<Outrigger>& outrigger)
+        SetPointOutriggerController(Outrigger& outrigger)
                 : OutriggerController(outrigger, "Set Point Outrigger Controller") {}
 
         void SetSetPoint(double setPoint) {
@@ -52,7 +51,7 @@ namespace garage {
 
         void Control() override;
 
-        void ProcessCommand(Command& command) override;
+        void ProcessCommand(const Command& command) override;
     };
 
     class RawOutriggerController : public OutriggerController {
@@ -60,10 +59,10 @@ namespace garage {
         double m_Output = 0.0;
 
     public:
-        RawOutriggerController(std::weak_ptr<Outrigger>& outrigger)
+        RawOutriggerController(Outrigger& outrigger)
                 : OutriggerController(outrigger, "Raw Outrigger Controller") {}
 
-        void ProcessCommand(Command& command) override;
+        void ProcessCommand(const Command& command) override;
 
         void SetRawOutput(double output) {
             m_Output = output;
@@ -76,29 +75,25 @@ namespace garage {
         void Control() override;
     };
 
-    class Outrigger : public lib::ControllableSubsystem<Outrigger> {
+    class Outrigger : public lib::StaticControllableSubsystem<Outrigger, RawOutriggerController, SetPointOutriggerController> {
         friend class RawOutriggerController;
 
         friend class SetPointOutriggerController;
 
     protected:
-        rev::CANSparkMax
-                m_OutriggerMaster{OUTRIGGER_ARM_MASTER, rev::CANSparkMax::MotorType::kBrushless},
-                m_OutriggerSlave{OUTRIGGER_ARM_SLAVE, rev::CANSparkMax::MotorType::kBrushless},
-                m_OutriggerWheel{OUTRIGGER_WHEEL, rev::CANSparkMax::MotorType::kBrushless};
-        rev::CANPIDController m_OutriggerController = m_OutriggerMaster.GetPIDController();
-        rev::CANEncoder m_Encoder = m_OutriggerMaster.GetEncoder();
+        lib::SparkMax m_OutriggerMaster{OUTRIGGER_ARM_MASTER}, m_OutriggerSlave{OUTRIGGER_ARM_SLAVE}, m_OutriggerWheel{OUTRIGGER_WHEEL};
+        lib::Encoder& m_Encoder = m_OutriggerMaster.GetEncoder();
         double m_EncoderPosition = OUTRIGGER_UPPER, m_Angle = OUTRIGGER_STOW_ANGLE, m_WheelOutput = 0.0;
-        std::shared_ptr<SetPointOutriggerController> m_SetPointController;
-        std::shared_ptr<RawOutriggerController> m_RawController;
 
         void StopMotors();
 
         void Update() override;
 
-        bool ShouldUnlock(Command& command) override;
+        bool ShouldUnlock(const Command& command) override;
+
+        void UpdateUnlocked(const Command& command) override;
 
-        void UpdateUnlocked(Command& command) override;
+        void FillTelemetry(lib::SubsystemTelemetry& telemetry) override;
 
     public:
         Outrigger(std::shared_ptr<Robot>& robot);
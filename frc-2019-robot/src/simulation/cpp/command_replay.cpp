@@ -0,0 +1,87 @@
+#include <robot.hpp>
+
+#include <plant/robot_plant.hpp>
+
+#include <lib/clock.hpp>
+#include <lib/logger.hpp>
+#include <lib/command_log.hpp>
+
+#include <hal/HAL.h>
+
+#include <wpi/raw_ostream.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#ifndef SIMULATION_OUTPUT_DIRECTORY
+#define SIMULATION_OUTPUT_DIRECTORY "/tmp" // Set to the build directory by CMake, anywhere outside of the checkout
+#endif
+
+using namespace garage;
+
+/**
+ * Feeds a command log pulled off the robot back through the control loop with every device simulated, as fast as
+ * the loop can go. The robot clock follows the recorded timestamps so timed routines see the same times as in the match.
+ * A Chrome trace of every routine is written to routine_trace in the output directory at the end.
+ * Usage: CommandReplay <command log file> [output directory, the build directory by default]
+ */
+int main(int argc, char** argv) {
+    if (argc != 2 && argc != 3) {
+        wpi::errs() << "Usage: " << argv[0] << " <command log file> [output directory]\n";
+        return 1;
+    }
+    const std::string outputDirectory = argc == 3 ? argv[2] : SIMULATION_OUTPUT_DIRECTORY;
+    const std::string
+            flightRecorderDirectory = outputDirectory + "/flight_recorder",
+            routineTraceDirectory = outputDirectory + "/routine_trace";
+    if (!HAL_Initialize(500, 0)) {
+        wpi::errs() << "Could not initialize the HAL\n";
+        return 1;
+    }
+    auto clock = std::make_shared<lib::SimulatedClock>();
+    Robot robot;
+    auto& config = robot.GetConfig();
+    config.enableCommandLog = false;
+    config.flightRecorderDirectory = flightRecorderDirectory.c_str();
+    config.enableRoutineTracer = true;
+    config.routineTraceDirectory = routineTraceDirectory.c_str();
+    robot.SetClock(clock);
+    robot.RobotInit();
+    plant::RobotPlant plant;
+    plant.Initialize();
+    lib::CommandLogReader reader;
+    if (!reader.Open(argv[1], robot.GetCommandRoutineNames())) {
+        lib::Logger::StopAsync();
+        return 1;
+    }
+
+    Command command{};
+    RoutineRequests routines;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < reader.GetRecordCount(); i++) {
+        const lib::CommandRecord& record = reader.GetRecord(i);
+        const lib::Clock::TimePoint time(std::chrono::microseconds(record.timestamp));
+        if (record.isReset) {
+            // The robot was disabled until now so nothing moved
+            clock->SetTime(time);
+            robot.Reset();
+        } else {
+            plant.Step(time - clock->Now());
+            clock->SetTime(time);
+        }
+        reader.GetCommand(i, command, routines);
+        robot.ReplayPeriodic(command, routines);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    robot.DisabledInit();
+    lib::Logger::StopAsync();
+
+    const double
+            seconds = std::chrono::duration<double>(end - start).count(),
+            recorded = std::chrono::duration<double>(clock->Now().time_since_epoch()).count();
+    wpi::errs() << "Replayed " << reader.GetRecordCount() << " loops in " << static_cast<long>(seconds * 1000.0) << " ms, "
+                << static_cast<long>(reader.GetRecordCount() / seconds) << " loops per second, "
+                << static_cast<long>(recorded / seconds) << " times faster than the recording\n";
+    return 0;
+}
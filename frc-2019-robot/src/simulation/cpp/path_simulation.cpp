@@ -0,0 +1,268 @@
+#include <robot.hpp>
+
+#include <plant/robot_plant.hpp>
+
+#include <lib/clock.hpp>
+#include <lib/logger.hpp>
+#include <lib/auto_routine_from_csv.hpp>
+
+#include <hal/HAL.h>
+
+#include <wpi/Path.h>
+
+#include <frc/Filesystem.h>
+
+#include <garage_math/garage_math.hpp>
+
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/wait.h>
+
+#include <cmath>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#define PATH_SIMULATION_TIMEOUT 3.0 // Seconds past the end of the trajectory before a path counts as not completed
+#define PATH_SIMULATION_NAME_SIZE 64 // Characters including the terminator, longer names are truncated in the report
+#define PATH_SIMULATION_SIDE_SUFFIX ".left.pf1.csv"
+
+using namespace garage;
+
+/**
+ * Sent from the workers to the report through a pipe as is, so it only holds plain values
+ */
+struct PathResult {
+    std::size_t index;
+    char name[PATH_SIMULATION_NAME_SIZE];
+    int segments;
+    double trajectoryTime, completionTime; // Seconds, completion is negative when the followers never finished
+    double maxCrossTrackError, rmsCrossTrackError, finalPositionError; // Meters
+    double finalHeadingError; // Degrees
+};
+
+static_assert(std::is_trivially_copyable<PathResult>::value, "Path results are written straight into a pipe");
+
+/**
+ * Names of every path with both sides generated, the way AutoRoutineFromCSV takes them
+ */
+std::vector<std::string> FindPaths(const std::string& directory) {
+    std::vector<std::string> names;
+    DIR* pathDirectory = opendir(directory.c_str());
+    if (!pathDirectory) {
+        std::fprintf(stderr, "Could not open path directory %s: %s\n", directory.c_str(), std::strerror(errno));
+        return names;
+    }
+    const std::string suffix = PATH_SIMULATION_SIDE_SUFFIX;
+    while (dirent* entry = readdir(pathDirectory)) {
+        const std::string fileName = entry->d_name;
+        if (fileName.size() > suffix.size() && fileName.compare(fileName.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            names.push_back(fileName.substr(0, fileName.size() - suffix.size()));
+        }
+    }
+    closedir(pathDirectory);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+/**
+ * Reads the center trajectory, which the sides were generated from, to measure the robot against
+ */
+std::vector<Segment> ReadTrajectory(const std::string& path) {
+    std::vector<Segment> trajectory;
+    auto* pathFile = std::fopen(path.c_str(), "r");
+    if (!pathFile) return trajectory;
+    int count = 0, character = 0;
+    while ((character = std::getc(pathFile)) != EOF) {
+        if (character == '\n') {
+            count++;
+        }
+    }
+    rewind(pathFile);
+    // CSV has a one line header
+    if (count > 1) {
+        trajectory.resize(static_cast<std::size_t>(count - 1));
+        pathfinder_deserialize_csv(pathFile, trajectory.data());
+    }
+    std::fclose(pathFile);
+    return trajectory;
+}
+
+/**
+ * Meters from the closest point of the trajectory drawn as line segments
+ */
+double GetDistanceToTrajectory(const std::vector<Segment>& trajectory, double x, double y) {
+    double closest = std::hypot(x - trajectory.front().x, y - trajectory.front().y);
+    for (std::size_t i = 1; i < trajectory.size(); i++) {
+        const Segment &start = trajectory[i - 1], &end = trajectory[i];
+        const double dx = end.x - start.x, dy = end.y - start.y, lengthSquared = dx * dx + dy * dy;
+        const double along = lengthSquared > 0.0 ? math::clamp(((x - start.x) * dx + (y - start.y) * dy) / lengthSquared, 0.0, 1.0) : 0.0;
+        closest = std::min(closest, std::hypot(x - (start.x + along * dx), y - (start.y + along * dy)));
+    }
+    return closest;
+}
+
+/**
+ * Starts the robot on the first point of the path and runs the auto routine until both followers finish
+ */
+PathResult SimulatePath(Robot& robot, std::shared_ptr<Robot>& robotPointer, lib::SimulatedClock& clock, plant::RobotPlant& plant,
+                        const std::string& directory, const std::string& name) {
+    PathResult result{};
+    std::strncpy(result.name, name.c_str(), PATH_SIMULATION_NAME_SIZE - 1);
+    result.completionTime = -1.0;
+    const std::vector<Segment> reference = ReadTrajectory(directory + "/" + name + ".pf1.csv");
+    if (reference.empty()) {
+        std::fprintf(stderr, "Could not read the center trajectory of %s\n", name.c_str());
+        return result;
+    }
+    result.segments = static_cast<int>(reference.size());
+    for (const auto& segment : reference) {
+        result.trajectoryTime += segment.dt;
+    }
+    robot.AutonomousInit();
+    std::shared_ptr<lib::AutoRoutineFromCSV> routine = std::make_shared<lib::AutoRoutineFromCSV>(robotPointer, name, name);
+    routine->PostInitialize();
+    plant.ResetDrive({reference.front().x, reference.front().y, reference.front().heading});
+    robot.GetRoutineManager().AddRoutine(routine);
+
+    const auto period = std::chrono::duration_cast<lib::Clock::Duration>(std::chrono::duration<double>(robot.GetPeriod()));
+    const long loops = std::lround((result.trajectoryTime + PATH_SIMULATION_TIMEOUT) / robot.GetPeriod());
+    double squaredErrorSum = 0.0;
+    long samples = 0;
+    for (long i = 1; i <= loops; i++) {
+        clock.Advance(period);
+        robot.AutonomousPeriodic();
+        plant.Step(period);
+        const plant::Pose pose = plant.GetDrivePose();
+        const double crossTrackError = GetDistanceToTrajectory(reference, pose.x, pose.y);
+        result.maxCrossTrackError = std::max(result.maxCrossTrackError, crossTrackError);
+        squaredErrorSum += crossTrackError * crossTrackError;
+        samples++;
+        if (routine->IsTrajectoryFinished()) {
+            result.completionTime = i * robot.GetPeriod();
+            break;
+        }
+    }
+    const plant::Pose pose = plant.GetDrivePose();
+    result.rmsCrossTrackError = std::sqrt(squaredErrorSum / samples);
+    result.finalPositionError = std::hypot(pose.x - reference.back().x, pose.y - reference.back().y);
+    result.finalHeadingError = r2d(std::remainder(pose.heading - reference.back().heading, 2.0 * M_PI));
+    return result;
+}
+
+/**
+ * Runs every stride-th path from first in its own robot. Each worker is a process since the HAL, the simulated
+ * devices and the logger are all process wide.
+ */
+void RunWorker(const std::string& directory, const std::vector<std::string>& names, std::size_t first, std::size_t stride,
+               int resultDescriptor) {
+    if (!HAL_Initialize(500, 0)) {
+        std::fprintf(stderr, "Could not initialize the HAL\n");
+        return;
+    }
+    auto clock = std::make_shared<lib::SimulatedClock>();
+    Robot robot;
+    auto& config = robot.GetConfig();
+    config.logLevel = lib::Logger::LogLevel::k_Warning;
+    config.enableFlightRecorder = config.enableCommandLog = false;
+    // Only the drive moves during paths
+    config.enableElevator = config.enableFlipper = config.enableBallIntake = config.enableHatchIntake = config.enableOutrigger = false;
+    robot.SetClock(clock);
+    robot.RobotInit();
+    plant::RobotPlant plant;
+    plant.Initialize();
+    // Routines want a shared pointer, the robot outlives all of them
+    std::shared_ptr<Robot> robotPointer(&robot, [](Robot*) {});
+    for (std::size_t i = first; i < names.size(); i += stride) {
+        PathResult result = SimulatePath(robot, robotPointer, *clock, plant, directory, names[i]);
+        result.index = i;
+        if (write(resultDescriptor, &result, sizeof(result)) != static_cast<ssize_t>(sizeof(result))) {
+            std::fprintf(stderr, "Could not send the result of %s\n", names[i].c_str());
+        }
+    }
+    robot.DisabledInit();
+    lib::Logger::StopAsync();
+}
+
+/**
+ * Follows every deployed path with the auto routine against the drive plant, one worker process per core, and reports
+ * how closely each was tracked. Run from the project directory so the deploy directory is found like on the desktop.
+ */
+int main() {
+    wpi::SmallString<PATH_LENGTH> directoryPath;
+    frc::filesystem::GetDeployDirectory(directoryPath);
+    wpi::sys::path::append(directoryPath, "output");
+    const std::string directory = directoryPath.c_str();
+    const std::vector<std::string> names = FindPaths(directory);
+    if (names.empty()) {
+        std::fprintf(stderr, "No paths in %s\n", directory.c_str());
+        return 1;
+    }
+    const std::size_t workerCount = std::max(1u, std::min(std::thread::hardware_concurrency(), static_cast<unsigned>(names.size())));
+
+    const auto start = std::chrono::steady_clock::now();
+    // Fork before anything starts threads, each worker sets up its own robot
+    std::vector<int> resultDescriptors;
+    std::vector<pid_t> workers;
+    for (std::size_t worker = 0; worker < workerCount; worker++) {
+        int descriptors[2];
+        if (pipe(descriptors) != 0) {
+            std::fprintf(stderr, "Could not create pipe: %s\n", std::strerror(errno));
+            break;
+        }
+        const pid_t pid = fork();
+        if (pid == 0) {
+            close(descriptors[0]);
+            RunWorker(directory, names, worker, workerCount, descriptors[1]);
+            close(descriptors[1]);
+            // Skip static destructors, the parent still owns everything it had before the fork
+            _exit(0);
+        }
+        close(descriptors[1]);
+        if (pid < 0) {
+            std::fprintf(stderr, "Could not start worker: %s\n", std::strerror(errno));
+            close(descriptors[0]);
+            break;
+        }
+        workers.push_back(pid);
+        resultDescriptors.push_back(descriptors[0]);
+    }
+    std::vector<PathResult> results;
+    for (int descriptor : resultDescriptors) {
+        PathResult result;
+        while (read(descriptor, &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result))) {
+            results.push_back(result);
+        }
+        close(descriptor);
+    }
+    for (pid_t worker : workers) {
+        waitpid(worker, nullptr, 0);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    std::sort(results.begin(), results.end(), [](const PathResult& a, const PathResult& b) { return a.index < b.index; });
+
+    std::printf("%-40s | %8s %9s %10s %10s %10s %11s\n", "Path",
+                "Path s", "Finish s", "Max XTE m", "RMS XTE m", "End Pos m", "End Head deg");
+    double simulated = 0.0;
+    for (const auto& result : results) {
+        std::printf("%-40s | %8.2f ", result.name, result.trajectoryTime);
+        if (result.completionTime >= 0.0) std::printf("%9.2f ", result.completionTime); else std::printf("%9s ", "never");
+        std::printf("%10.3f %10.3f %10.3f %11.1f\n", result.maxCrossTrackError, result.rmsCrossTrackError,
+                    result.finalPositionError, result.finalHeadingError);
+        simulated += result.completionTime >= 0.0 ? result.completionTime : result.trajectoryTime + PATH_SIMULATION_TIMEOUT;
+    }
+    if (results.size() < names.size()) {
+        std::fprintf(stderr, "Only %zu of %zu paths reported back\n", results.size(), names.size());
+    }
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("Simulated %zu paths, %.1f seconds of driving, in %.0f ms on %zu workers\n",
+                results.size(), simulated, seconds * 1000.0, workers.size());
+    return results.size() == names.size() ? 0 : 1;
+}
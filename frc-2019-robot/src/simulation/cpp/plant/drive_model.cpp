@@ -0,0 +1,96 @@
+#include <plant/drive_model.hpp>
+
+#include <cmath>
+
+namespace garage {
+    namespace plant {
+        double DriveModel::GetSideVelocity(Side side) const {
+            const double turn = m_AngularVelocity * m_TrackWidth * 0.5;
+            return side == Side::k_Left ? m_Velocity - turn : m_Velocity + turn;
+        }
+
+        double DriveModel::GetShaftRotationsPerMeter(Side side) const {
+            const double rotations = m_GearRatio / (2.0 * M_PI * m_WheelRadius);
+            return side == Side::k_Left ? rotations : -rotations;
+        }
+
+        void DriveModel::AddController(lib::SimulatedSparkMax& spark, Side side) {
+            m_Controllers.push_back({SparkMaxModel(spark), side});
+            UpdateSensors();
+        }
+
+        void DriveModel::Reset(const Pose& pose) {
+            m_Pose = pose;
+            m_Velocity = m_AngularVelocity = m_LeftDistance = m_RightDistance = 0.0;
+            for (auto& controller : m_Controllers) {
+                controller.model.Reset();
+            }
+            UpdateSensors();
+            for (auto& controller : m_Controllers) {
+                controller.model.GetSpark().GetEncoder().SetPosition(0.0);
+            }
+        }
+
+        void DriveModel::Step(double period) {
+            // Forward force on each side split into what the voltage drives and what back EMF takes away per meter per second
+            double leftForce = 0.0, rightForce = 0.0, leftDamping = 0.0, rightDamping = 0.0;
+            for (auto& controller : m_Controllers) {
+                auto& spark = controller.model.GetSpark();
+                const double
+                        rotationsPerMeter = GetShaftRotationsPerMeter(controller.side),
+                        direction = spark.IsInverted() ? -1.0 : 1.0,
+                        position = (controller.side == Side::k_Left ? m_LeftDistance : m_RightDistance) * rotationsPerMeter,
+                        rpm = GetSideVelocity(controller.side) * rotationsPerMeter * 60.0;
+                const double output = controller.model.Update(period, direction * position, direction * rpm);
+                if (output == 0.0 && !spark.IsBrakeMode()) continue;
+                // Newtons at the carpet per newton meter at the shaft, signed by which way the motor is mounted
+                const double forcePerTorque = rotationsPerMeter * 2.0 * M_PI;
+                const double force = forcePerTorque * m_Motor.kt * GetVoltage(spark, output) / m_Motor.resistance;
+                const double damping = forcePerTorque * forcePerTorque * m_Motor.kt / (m_Motor.resistance * m_Motor.kv);
+                if (controller.side == Side::k_Left) {
+                    leftForce += force;
+                    leftDamping += damping;
+                } else {
+                    rightForce += force;
+                    rightDamping += damping;
+                }
+            }
+            // Implicit step of the forward and turning velocities, which are coupled when the sides damp differently
+            const double halfTrack = m_TrackWidth * 0.5;
+            const double
+                    a = m_Mass + period * (leftDamping + rightDamping),
+                    b = period * halfTrack * (rightDamping - leftDamping),
+                    c = m_Inertia + period * halfTrack * halfTrack * (leftDamping + rightDamping),
+                    linear = m_Mass * m_Velocity + period * (leftForce + rightForce),
+                    angular = m_Inertia * m_AngularVelocity + period * halfTrack * (rightForce - leftForce);
+            const double determinant = a * c - b * b;
+            m_Velocity = (linear * c - angular * b) / determinant;
+            m_AngularVelocity = (angular * a - linear * b) / determinant;
+            m_LeftDistance += GetSideVelocity(Side::k_Left) * period;
+            m_RightDistance += GetSideVelocity(Side::k_Right) * period;
+            m_Pose.heading += m_AngularVelocity * period;
+            m_Pose.x += m_Velocity * std::cos(m_Pose.heading) * period;
+            m_Pose.y += m_Velocity * std::sin(m_Pose.heading) * period;
+            for (auto& controller : m_Controllers) {
+                auto& spark = controller.model.GetSpark();
+                const double output = spark.GetAppliedOutput();
+                const bool isDriving = output != 0.0 || spark.IsBrakeMode();
+                const double shaftSpeed = GetSideVelocity(controller.side) * GetShaftRotationsPerMeter(controller.side) * 2.0 * M_PI;
+                spark.SetOutputCurrent(isDriving ? std::fabs(m_Motor.GetCurrent(GetVoltage(spark, output), shaftSpeed)) : 0.0);
+            }
+            UpdateSensors();
+        }
+
+        void DriveModel::UpdateSensors() {
+            for (auto& controller : m_Controllers) {
+                auto& spark = controller.model.GetSpark();
+                const double
+                        rotationsPerMeter = GetShaftRotationsPerMeter(controller.side),
+                        direction = spark.IsInverted() ? -1.0 : 1.0,
+                        position = (controller.side == Side::k_Left ? m_LeftDistance : m_RightDistance) * rotationsPerMeter,
+                        rpm = GetSideVelocity(controller.side) * rotationsPerMeter * 60.0;
+                spark.GetEncoder().SetSimulatedState(direction * position, direction * rpm);
+            }
+        }
+    }
+}
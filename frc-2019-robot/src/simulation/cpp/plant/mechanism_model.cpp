@@ -0,0 +1,102 @@
+#include <plant/mechanism_model.hpp>
+
+#include <cmath>
+
+namespace garage {
+    namespace plant {
+        double MechanismModel::GetOutputAngle() const {
+            return m_Position / m_GearRatio * 2.0 * M_PI;
+        }
+
+        double MechanismModel::GetVelocity() const {
+            return m_Velocity * 60.0 / (2.0 * M_PI);
+        }
+
+        void MechanismModel::AddController(lib::SimulatedSparkMax& spark) {
+            m_Controllers.emplace_back(spark);
+            UpdateSensors();
+        }
+
+        void MechanismModel::AddLimitSwitch(lib::SimulatedLimitSwitch& limitSwitch, double position, bool isForward) {
+            m_LimitSwitches.push_back({&limitSwitch, position, isForward});
+            UpdateSensors();
+        }
+
+        void MechanismModel::Reset(double position) {
+            m_Position = position;
+            m_Velocity = 0.0;
+            for (auto& controller : m_Controllers) {
+                controller.Reset();
+            }
+            UpdateSensors();
+            for (auto& controller : m_Controllers) {
+                auto& spark = controller.GetSpark();
+                spark.GetEncoder().SetPosition(spark.IsInverted() ? -position : position);
+            }
+        }
+
+        void MechanismModel::Step(double period) {
+            const double rpm = GetVelocity();
+            // Split motor torque into what the voltage drives and what back EMF takes away per unit of speed
+            double drivenTorque = 0.0, damping = 0.0;
+            for (auto& controller : m_Controllers) {
+                auto& spark = controller.GetSpark();
+                const double direction = spark.IsInverted() ? -1.0 : 1.0;
+                const double output = controller.Update(period, direction * m_Position, direction * rpm);
+                // Coasting leaves the windings open, braking shorts them
+                if (output == 0.0 && !spark.IsBrakeMode()) continue;
+                drivenTorque += m_Motor.kt * GetVoltage(spark, output) / m_Motor.resistance;
+                damping += m_Motor.kt / (m_Motor.resistance * m_Motor.kv);
+            }
+            // Reflect the load to the motor shaft
+            const double inertia = GetInertia() / (m_GearRatio * m_GearRatio);
+            const double torque = drivenTorque + GetLoadTorque() / m_GearRatio;
+            m_Velocity = (m_Velocity + period * torque / inertia) / (1.0 + period * damping / inertia);
+            m_Position += m_Velocity * period / (2.0 * M_PI);
+            if (m_Position <= m_MinPosition) {
+                m_Position = m_MinPosition;
+                if (m_Velocity < 0.0) m_Velocity = 0.0;
+            } else if (m_Position >= m_MaxPosition) {
+                m_Position = m_MaxPosition;
+                if (m_Velocity > 0.0) m_Velocity = 0.0;
+            }
+            for (auto& controller : m_Controllers) {
+                auto& spark = controller.GetSpark();
+                const double output = spark.GetAppliedOutput();
+                const bool isDriving = output != 0.0 || spark.IsBrakeMode();
+                spark.SetOutputCurrent(isDriving ? std::fabs(m_Motor.GetCurrent(GetVoltage(spark, output), m_Velocity)) : 0.0);
+            }
+            UpdateSensors();
+        }
+
+        void MechanismModel::UpdateSensors() {
+            const double rpm = GetVelocity();
+            for (auto& controller : m_Controllers) {
+                auto& spark = controller.GetSpark();
+                const double direction = spark.IsInverted() ? -1.0 : 1.0;
+                spark.GetEncoder().SetSimulatedState(direction * m_Position, direction * rpm);
+            }
+            for (auto& binding : m_LimitSwitches) {
+                binding.limitSwitch->SetPressed(binding.isForward
+                                                ? m_Position >= binding.position - PLANT_LIMIT_SWITCH_TRAVEL
+                                                : m_Position <= binding.position + PLANT_LIMIT_SWITCH_TRAVEL);
+            }
+        }
+
+        double ElevatorModel::GetInertia() const {
+            return m_Mass * m_DrumRadius * m_DrumRadius;
+        }
+
+        double ElevatorModel::GetLoadTorque() const {
+            return -m_Mass * PLANT_GRAVITY * m_DrumRadius;
+        }
+
+        double ArmModel::GetInertia() const {
+            return m_Mass * m_CenterOfMassLength * m_CenterOfMassLength;
+        }
+
+        double ArmModel::GetLoadTorque() const {
+            return -m_Mass * PLANT_GRAVITY * m_CenterOfMassLength * std::cos(GetOutputAngle() + m_AngleOffset);
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#include <plant/robot_plant.hpp>
+
+#include <lib/logger.hpp>
+
+#include <hardware_map.hpp>
+
+#include <garage_math/garage_math.hpp>
+
+#include <cmath>
+#include <chrono>
+
+namespace garage {
+    namespace plant {
+        void RobotPlant::Initialize() {
+            auto leftMaster = lib::SimulatedSparkMax::Find(DRIVE_LEFT_MASTER), leftSlave = lib::SimulatedSparkMax::Find(DRIVE_LEFT_SLAVE),
+                    rightMaster = lib::SimulatedSparkMax::Find(DRIVE_RIGHT_MASTER), rightSlave = lib::SimulatedSparkMax::Find(DRIVE_RIGHT_SLAVE);
+            if (leftMaster && leftSlave && rightMaster && rightSlave) {
+                m_Drive = std::make_unique<DriveModel>(DcMotor::Neo(), DRIVE_PLANT_GEAR_RATIO, DRIVE_PLANT_WHEEL_RADIUS, AUTO_WHEELBASE_DISTANCE,
+                                                       DRIVE_PLANT_MASS, DRIVE_PLANT_MOMENT_OF_INERTIA);
+                m_Drive->AddController(*leftMaster, DriveModel::Side::k_Left);
+                m_Drive->AddController(*leftSlave, DriveModel::Side::k_Left);
+                m_Drive->AddController(*rightMaster, DriveModel::Side::k_Right);
+                m_Drive->AddController(*rightSlave, DriveModel::Side::k_Right);
+            } else {
+                lib::Logger::Log(lib::Logger::LogLevel::k_Info, "[Plant] No drive devices, not simulating it");
+            }
+            auto elevatorMaster = lib::SimulatedSparkMax::Find(ELEVATOR_MASTER), elevatorSlave = lib::SimulatedSparkMax::Find(ELEVATOR_SLAVE);
+            if (elevatorMaster && elevatorSlave) {
+                m_Elevator = std::make_unique<ElevatorModel>(DcMotor::Neo(), ELEVATOR_PLANT_GEAR_RATIO, ELEVATOR_PLANT_DRUM_RADIUS,
+                                                             ELEVATOR_PLANT_MASS, ELEVATOR_MIN, ELEVATOR_PLANT_TRAVEL);
+                m_Elevator->AddController(*elevatorMaster);
+                m_Elevator->AddController(*elevatorSlave);
+                // Only the slave has a limit switch wired
+                m_Elevator->AddLimitSwitch(elevatorSlave->GetReverseLimitSwitch(), ELEVATOR_MIN, false);
+            } else {
+                lib::Logger::Log(lib::Logger::LogLevel::k_Info, "[Plant] No elevator devices, not simulating it");
+            }
+            auto flipper = lib::SimulatedSparkMax::Find(FLIPPER);
+            if (flipper) {
+                m_Flipper = std::make_unique<ArmModel>(DcMotor::Neo(), FLIPPER_PLANT_GEAR_RATIO, FLIPPER_PLANT_MASS, FLIPPER_PLANT_CENTER_OF_MASS,
+                                                       math::d2r(FLIPPER_COM_ANGLE_FF_OFFSET), FLIPPER_LOWER, FLIPPER_UPPER);
+                m_Flipper->AddController(*flipper);
+                m_Flipper->AddLimitSwitch(flipper->GetReverseLimitSwitch(), FLIPPER_LOWER, false);
+                m_Flipper->AddLimitSwitch(flipper->GetForwardLimitSwitch(), FLIPPER_UPPER, true);
+            } else {
+                lib::Logger::Log(lib::Logger::LogLevel::k_Info, "[Plant] No flipper device, not simulating it");
+            }
+        }
+
+        void RobotPlant::Reset(double elevatorPosition, double flipperAngle) {
+            if (m_Elevator) m_Elevator->Reset(elevatorPosition);
+            if (m_Flipper) {
+                m_Flipper->Reset(math::map(flipperAngle, FLIPPER_LOWER_ANGLE, FLIPPER_UPPER_ANGLE, FLIPPER_LOWER, FLIPPER_UPPER));
+            }
+        }
+
+        void RobotPlant::ResetDrive(const Pose& pose) {
+            if (m_Drive) m_Drive->Reset(pose);
+        }
+
+        void RobotPlant::Step(lib::Clock::Duration duration) {
+            const long steps = std::lround(std::chrono::duration<double>(duration).count() / PLANT_PERIOD);
+            for (long i = 0; i < steps; i++) {
+                if (m_Drive) m_Drive->Step(PLANT_PERIOD);
+                if (m_Elevator) m_Elevator->Step(PLANT_PERIOD);
+                if (m_Flipper) m_Flipper->Step(PLANT_PERIOD);
+            }
+        }
+
+        double RobotPlant::GetElevatorPosition() const {
+            return m_Elevator ? m_Elevator->GetPosition() : 0.0;
+        }
+
+        double RobotPlant::GetFlipperAngle() const {
+            return m_Flipper ? math::map(m_Flipper->GetPosition(), FLIPPER_LOWER, FLIPPER_UPPER, FLIPPER_LOWER_ANGLE, FLIPPER_UPPER_ANGLE) : 0.0;
+        }
+
+        Pose RobotPlant::GetDrivePose() const {
+            return m_Drive ? m_Drive->GetPose() : Pose{};
+        }
+    }
+}
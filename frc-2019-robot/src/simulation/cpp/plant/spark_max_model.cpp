@@ -0,0 +1,112 @@
+#include <plant/spark_max_model.hpp>
+
+#include <plant/dc_motor.hpp>
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace garage {
+    namespace plant {
+        double MoveTowards(double value, double target, double maxStep) {
+            if (std::fabs(target - value) <= maxStep) return target;
+            return value + (target > value ? maxStep : -maxStep);
+        }
+
+        double GetVoltage(lib::SimulatedSparkMax& spark, double output) {
+            const double nominalVoltage = spark.GetNominalVoltage() > 0.0 ? spark.GetNominalVoltage() : PLANT_BATTERY_VOLTAGE;
+            return (spark.IsInverted() ? -output : output) * nominalVoltage;
+        }
+
+        void SparkMaxModel::Reset() {
+            m_WasClosedLoop = false;
+            m_ProfilePosition = m_ProfileVelocity = m_Integral = m_LastError = m_Output = 0.0;
+        }
+
+        double SparkMaxModel::Update(double period, double position, double velocity) {
+            double output;
+            auto leader = m_Spark.GetLeader();
+            if (leader) {
+                // Followers turn their motor the way the leader turns its own, so an inverted leader inverts them too
+                const bool isOpposite = leader->IsInverted() != m_Spark.IsFollowerInverted();
+                output = isOpposite ? -leader->GetAppliedOutput() : leader->GetAppliedOutput();
+                m_WasClosedLoop = false;
+            } else {
+                double wantedOutput, rampRate;
+                if (m_Spark.IsClosedLoop()) {
+                    wantedOutput = UpdateClosedLoop(period, position, velocity);
+                    rampRate = m_Spark.GetClosedLoopRampRate();
+                } else {
+                    wantedOutput = m_Spark.GetOutput();
+                    if (std::fabs(wantedOutput) < m_Spark.GetInputDeadband()) wantedOutput = 0.0;
+                    rampRate = m_Spark.GetOpenLoopRampRate();
+                    m_WasClosedLoop = false;
+                }
+                // Ramp rate is the seconds from neutral to full output
+                const double maxStep = rampRate > 0.0 ? period / rampRate : std::numeric_limits<double>::infinity();
+                output = MoveTowards(m_Output, wantedOutput, maxStep);
+            }
+            // Limit switches only stop motion toward them
+            auto& forwardLimitSwitch = m_Spark.GetForwardLimitSwitch();
+            auto& reverseLimitSwitch = m_Spark.GetReverseLimitSwitch();
+            if (output > 0.0 && forwardLimitSwitch.IsEnabled() && forwardLimitSwitch.Get()) output = 0.0;
+            if (output < 0.0 && reverseLimitSwitch.IsEnabled() && reverseLimitSwitch.Get()) output = 0.0;
+            m_Output = output;
+            m_Spark.SetAppliedOutput(output);
+            return output;
+        }
+
+        double SparkMaxModel::UpdateClosedLoop(double period, double position, double velocity) {
+            const auto& gains = m_Spark.GetGains(m_Spark.GetReferenceSlot());
+            const auto controlType = m_Spark.GetControlType();
+            if (!m_WasClosedLoop || controlType != m_ControlType) {
+                // Profiles start from wherever the mechanism is when closed loop begins
+                m_ProfilePosition = position;
+                m_ProfileVelocity = velocity;
+                m_Integral = 0.0;
+                m_LastError = 0.0;
+                m_ControlType = controlType;
+                m_WasClosedLoop = true;
+            }
+            const double reference = m_Spark.GetReference();
+            // Velocities are in RPM, acceleration in RPM per second
+            const double maxVelocityStep = gains.maxAcceleration > 0.0 ? gains.maxAcceleration * period : std::numeric_limits<double>::infinity();
+            switch (controlType) {
+                case lib::ControlType::k_SmartMotion: {
+                    const double remaining = reference - m_ProfilePosition, direction = remaining > 0.0 ? 1.0 : -1.0;
+                    const double stoppingDistance = gains.maxAcceleration > 0.0
+                                                    ? m_ProfileVelocity * m_ProfileVelocity / (2.0 * gains.maxAcceleration * 60.0) : 0.0;
+                    const bool isMovingToward = m_ProfileVelocity * direction > 0.0;
+                    const double targetVelocity = isMovingToward && std::fabs(remaining) <= stoppingDistance ? 0.0 : direction * gains.maxVelocity;
+                    m_ProfileVelocity = MoveTowards(m_ProfileVelocity, targetVelocity, maxVelocityStep);
+                    const double step = m_ProfileVelocity / 60.0 * period;
+                    if (step * remaining > 0.0 && std::fabs(step) >= std::fabs(remaining)) {
+                        m_ProfilePosition = reference;
+                        m_ProfileVelocity = 0.0;
+                    } else {
+                        m_ProfilePosition += step;
+                    }
+                    break;
+                }
+                case lib::ControlType::k_SmartVelocity: {
+                    m_ProfileVelocity = MoveTowards(m_ProfileVelocity, reference, maxVelocityStep);
+                    break;
+                }
+            }
+            // Velocity PID, the integral and derivative are per firmware period like on the controller
+            const double error = m_ProfileVelocity - velocity;
+            if (gains.iZone <= 0.0 || std::fabs(error) < gains.iZone) {
+                m_Integral += error;
+            } else {
+                m_Integral = 0.0;
+            }
+            if (gains.iMaxAccum > 0.0) m_Integral = std::max(-gains.iMaxAccum, std::min(m_Integral, gains.iMaxAccum));
+            const double derivative = error - m_LastError;
+            m_LastError = error;
+            const double nominalVoltage = m_Spark.GetNominalVoltage() > 0.0 ? m_Spark.GetNominalVoltage() : PLANT_BATTERY_VOLTAGE;
+            const double output = gains.ff * m_ProfileVelocity + gains.p * error + gains.i * m_Integral + gains.d * derivative
+                                  + m_Spark.GetArbitraryFeedForward() / nominalVoltage;
+            return std::max(gains.minOutput, std::min(output, gains.maxOutput));
+        }
+    }
+}
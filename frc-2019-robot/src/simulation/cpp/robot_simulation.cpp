@@ -0,0 +1,79 @@
+#include <robot.hpp>
+
+#include <plant/robot_plant.hpp>
+
+#include <lib/clock.hpp>
+#include <lib/logger.hpp>
+
+#include <hal/HAL.h>
+
+#include <wpi/raw_ostream.h>
+
+#include <chrono>
+#include <memory>
+
+#define SIMULATION_AUTONOMOUS_TIME 15 // Seconds
+#define SIMULATION_TELEOP_TIME 135 // Seconds
+
+#ifndef SIMULATION_OUTPUT_DIRECTORY
+#define SIMULATION_OUTPUT_DIRECTORY "/tmp" // Set to the build directory by CMake, anywhere outside of the checkout
+#endif
+
+using namespace garage;
+
+/**
+ * Calls the periodic functions of a mode back to back, moving the robot clock forward one period before each loop
+ * instead of sleeping, so a match takes as long as the code does
+ */
+template<typename TPeriodic>
+long RunMode(lib::SimulatedClock& clock, lib::Clock::Duration period, std::chrono::seconds duration, TPeriodic periodic) {
+    const long loops = duration / period;
+    for (long i = 0; i < loops; i++) {
+        clock.Advance(period);
+        periodic();
+    }
+    return loops;
+}
+
+/**
+ * Runs one match through the same loop as the robot with every device simulated and the elevator and flipper
+ * moving under physics. Only built with GARAGE_SIMULATION.
+ */
+int main() {
+    if (!HAL_Initialize(500, 0)) {
+        wpi::errs() << "Could not initialize the HAL\n";
+        return 1;
+    }
+    auto clock = std::make_shared<lib::SimulatedClock>();
+    Robot robot;
+    robot.GetConfig().flightRecorderDirectory = SIMULATION_OUTPUT_DIRECTORY "/flight_recorder";
+    robot.GetConfig().commandLogDirectory = SIMULATION_OUTPUT_DIRECTORY "/command_log";
+    robot.SetClock(clock);
+    robot.RobotInit();
+    plant::RobotPlant plant;
+    plant.Initialize();
+
+    const auto period = std::chrono::duration_cast<lib::Clock::Duration>(std::chrono::duration<double>(robot.GetPeriod()));
+    const auto start = std::chrono::steady_clock::now();
+    robot.AutonomousInit();
+    long loops = RunMode(*clock, period, std::chrono::seconds(SIMULATION_AUTONOMOUS_TIME), [&] {
+        robot.AutonomousPeriodic();
+        robot.RobotPeriodic();
+        plant.Step(period);
+    });
+    robot.TeleopInit();
+    loops += RunMode(*clock, period, std::chrono::seconds(SIMULATION_TELEOP_TIME), [&] {
+        robot.TeleopPeriodic();
+        robot.RobotPeriodic();
+        plant.Step(period);
+    });
+    robot.DisabledInit();
+    const auto end = std::chrono::steady_clock::now();
+    lib::Logger::StopAsync();
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    wpi::errs() << "Ran " << loops << " loops in " << static_cast<long>(seconds * 1000.0) << " ms, "
+                << static_cast<long>(loops / seconds) << " loops per second, "
+                << static_cast<long>(loops * robot.GetPeriod() / seconds) << " times faster than real time\n";
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include <robot.hpp>
+
+#include <plant/robot_plant.hpp>
+
+#include <lib/clock.hpp>
+#include <lib/logger.hpp>
+#include <lib/routine_pool.hpp>
+
+#include <routine/set_flipper_angle_routine.hpp>
+#include <routine/elevator_and_flipper_routine.hpp>
+#include <routine/set_elevator_position_routine.hpp>
+
+#include <hal/HAL.h>
+
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#define SIMULATION_PRESET_TIME 4.0 // Seconds each preset runs for after its routine is added
+
+using namespace garage;
+
+/**
+ * Time to set point, overshoot and settling time of one axis, within the same tolerance the routines finish at
+ */
+class Response {
+protected:
+    double m_Start = 0.0, m_Target = 0.0, m_Tolerance = 0.0;
+    double m_TimeToSetPoint = -1.0, m_SettlingTime = -1.0, m_Overshoot = 0.0, m_Final = 0.0;
+
+public:
+    Response() = default;
+
+    Response(double start, double target, double tolerance) : m_Start(start), m_Target(target), m_Tolerance(tolerance) {}
+
+    void Sample(double time, double value) {
+        m_Final = value;
+        if (std::fabs(value - m_Target) <= m_Tolerance) {
+            if (m_TimeToSetPoint < 0.0) m_TimeToSetPoint = time;
+            if (m_SettlingTime < 0.0) m_SettlingTime = time;
+        } else {
+            m_SettlingTime = -1.0;
+        }
+        // Overshoot is how far it went past the target in the direction it was traveling
+        const double past = m_Target >= m_Start ? value - m_Target : m_Target - value;
+        m_Overshoot = std::max(m_Overshoot, past);
+    }
+
+    void Print(bool isUsed) const {
+        if (!isUsed) {
+            std::printf("%8s %9s %9s %9s %8s", "-", "-", "-", "-", "-");
+            return;
+        }
+        std::printf("%8.1f ", m_Target);
+        if (m_TimeToSetPoint >= 0.0) std::printf("%9.0f ", m_TimeToSetPoint * 1000.0); else std::printf("%9s ", "never");
+        std::printf("%9.2f ", m_Overshoot);
+        if (m_SettlingTime >= 0.0) std::printf("%9.0f ", m_SettlingTime * 1000.0); else std::printf("%9s ", "never");
+        std::printf("%8.1f", m_Final);
+    }
+};
+
+struct Preset {
+    const char* name;
+    bool hasHeight, hasAngle;
+    double height, angle;
+};
+
+/**
+ * Runs every elevator and flipper preset from the bottom through the real routines and controllers against the plant.
+ * Times are in milliseconds, overshoot and where it ended up are in encoder ticks for the elevator and degrees for the flipper.
+ */
+int main() {
+    if (!HAL_Initialize(500, 0)) {
+        std::fprintf(stderr, "Could not initialize the HAL\n");
+        return 1;
+    }
+    auto clock = std::make_shared<lib::SimulatedClock>();
+    Robot robot;
+    auto& config = robot.GetConfig();
+    config.logLevel = lib::Logger::LogLevel::k_Warning;
+    config.enableFlightRecorder = config.enableCommandLog = false;
+    robot.SetClock(clock);
+    robot.RobotInit();
+    plant::RobotPlant plant;
+    plant.Initialize();
+    // Routines want a shared pointer, the robot outlives all of them
+    std::shared_ptr<Robot> robotPointer(&robot, [](Robot*) {});
+    // Resetting the robot between presets drops the last routine, so one of each is enough
+    lib::RoutinePool<ElevatorAndFlipperRoutine, 1> elevatorAndFlipperRoutines(robotPointer, 0.0, 0.0);
+    lib::RoutinePool<SetElevatorPositionRoutine, 1> setElevatorPositionRoutines(robotPointer, 0.0);
+    lib::RoutinePool<SetFlipperAngleRoutine, 1> setFlipperAngleRoutines(robotPointer, 0.0);
+
+    const std::vector<Preset> presets{
+            {"Bottom Hatch",         true,  false, config.bottomHatchHeight,        0.0},
+            {"Rocket Middle Hatch",  true,  false, config.rocketMiddleHatchHeight,  0.0},
+            {"Rocket Top Hatch",     true,  false, config.rocketTopHatchHeight,     0.0},
+            {"Rocket Bottom Ball",   true,  true,  config.rocketBottomBallHeight,   config.rocketBottomBallAngle},
+            {"Rocket Middle Ball",   true,  true,  config.rocketMiddleBallHeight,   config.rocketMiddleBallAngle},
+            {"Rocket Top Ball",      true,  true,  config.rocketTopBallHeight,      config.rocketTopBallAngle},
+            {"Cargo Ball Down",      true,  true,  config.cargoBallHeightDown,      config.cargoBallAngle},
+            {"Cargo Ball Up",        true,  true,  config.cargoBallHeightUp,        config.cargoBallAngle},
+            {"Ground Intake Ball",   true,  true,  config.groundIntakeBallHeight,   FLIPPER_UPPER_ANGLE},
+            {"Loading Intake Ball",  true,  true,  config.loadingIntakeBallHeight,  FLIPPER_UPPER_ANGLE},
+            {"Second Level Climb",   true,  false, config.secondLevelClimbHeight,   0.0},
+            {"Third Level Climb",    true,  false, config.thirdLevelClimbHeight,    0.0},
+            {"Flipper Stow",         false, true,  0.0,                             FLIPPER_STOW_ANGLE},
+            {"Flipper Upper",        false, true,  0.0,                             FLIPPER_UPPER_ANGLE}
+    };
+
+    std::printf("%-20s | %8s %9s %9s %9s %8s | %8s %9s %9s %9s %8s\n", "Preset",
+                "Height", "Reach ms", "Overshoot", "Settle ms", "Final", "Angle", "Reach ms", "Overshoot", "Settle ms", "Final");
+    const auto period = std::chrono::duration_cast<lib::Clock::Duration>(std::chrono::duration<double>(robot.GetPeriod()));
+    const long loops = std::lround(SIMULATION_PRESET_TIME / robot.GetPeriod());
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& preset : presets) {
+        robot.TeleopInit();
+        plant.Reset(ELEVATOR_MIN, FLIPPER_LOWER_ANGLE);
+        std::shared_ptr<lib::Routine> routine;
+        if (preset.hasHeight && preset.hasAngle) {
+            routine = elevatorAndFlipperRoutines.Acquire(preset.height, preset.angle);
+        } else if (preset.hasHeight) {
+            routine = setElevatorPositionRoutines.Acquire(preset.height);
+        } else {
+            routine = setFlipperAngleRoutines.Acquire(preset.angle);
+        }
+        robot.GetRoutineManager().AddRoutine(routine);
+        Response
+                elevatorResponse(plant.GetElevatorPosition(), preset.height, ELEVATOR_WITHIN_SET_POINT_AMOUNT),
+                flipperResponse(plant.GetFlipperAngle(), preset.angle, FLIPPER_WITHIN_ANGLE);
+        for (long i = 1; i <= loops; i++) {
+            clock->Advance(period);
+            robot.TeleopPeriodic();
+            plant.Step(period);
+            const double time = i * robot.GetPeriod();
+            elevatorResponse.Sample(time, plant.GetElevatorPosition());
+            flipperResponse.Sample(time, plant.GetFlipperAngle());
+        }
+        std::printf("%-20s | ", preset.name);
+        elevatorResponse.Print(preset.hasHeight);
+        std::printf(" | ");
+        flipperResponse.Print(preset.hasAngle);
+        std::printf("\n");
+    }
+    const auto end = std::chrono::steady_clock::now();
+    robot.DisabledInit();
+    lib::Logger::StopAsync();
+
+    const double simulated = presets.size() * SIMULATION_PRESET_TIME, seconds = std::chrono::duration<double>(end - start).count();
+    std::printf("Simulated %.0f seconds in %.0f ms, %.0f times faster than real time\n", simulated, seconds * 1000.0, simulated / seconds);
+    return 0;
+}
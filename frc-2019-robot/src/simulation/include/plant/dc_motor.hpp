@@ -0,0 +1,40 @@
+#pragma once
+
+#define NEO_NOMINAL_VOLTAGE 12.0 // Volts
+#define NEO_FREE_SPEED 5676.0 // RPM
+#define NEO_FREE_CURRENT 1.8 // Amperes
+#define NEO_STALL_TORQUE 2.6 // Newton meters
+#define NEO_STALL_CURRENT 105.0 // Amperes
+
+#define PLANT_BATTERY_VOLTAGE 12.0 // Volts, used when voltage compensation is off
+
+namespace garage {
+    namespace plant {
+        /**
+         * Brushed DC motor model, which brushless motors behind a controller follow closely enough
+         */
+        struct DcMotor {
+            double resistance; // Ohms
+            double kv; // Radians per second per volt
+            double kt; // Newton meters per ampere
+
+            static DcMotor FromSpecifications(double nominalVoltage, double freeSpeed, double freeCurrent,
+                                              double stallTorque, double stallCurrent) {
+                const double resistance = nominalVoltage / stallCurrent;
+                const double freeSpeedRadians = freeSpeed * 2.0 * 3.14159265358979 / 60.0;
+                return {resistance, freeSpeedRadians / (nominalVoltage - resistance * freeCurrent), stallTorque / stallCurrent};
+            }
+
+            static DcMotor Neo() {
+                return FromSpecifications(NEO_NOMINAL_VOLTAGE, NEO_FREE_SPEED, NEO_FREE_CURRENT, NEO_STALL_TORQUE, NEO_STALL_CURRENT);
+            }
+
+            /**
+             * Speed is of the motor shaft in radians per second
+             */
+            double GetCurrent(double voltage, double speed) const {
+                return (voltage - speed / kv) / resistance;
+            }
+        };
+    }
+}
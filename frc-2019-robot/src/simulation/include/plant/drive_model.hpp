@@ -0,0 +1,84 @@
+#pragma once
+
+#include <plant/dc_motor.hpp>
+#include <plant/spark_max_model.hpp>
+
+#include <vector>
+
+namespace garage {
+    namespace plant {
+        /**
+         * Meters and radians counter clockwise, the same frame Pathfinder trajectories use
+         */
+        struct Pose {
+            double x, y, heading;
+        };
+
+        /**
+         * Tank drive on flat carpet with no wheel slip. Each side is driven through a gearbox by Spark Maxes,
+         * the right side is mounted mirrored so it needs inverted controllers to drive forward like on the robot.
+         * Back EMF is integrated implicitly like in MechanismModel.
+         */
+        class DriveModel {
+        public:
+            enum class Side {
+                k_Left, k_Right
+            };
+
+        protected:
+            struct SideController {
+                SparkMaxModel model;
+                Side side;
+            };
+
+            DcMotor m_Motor;
+            double m_GearRatio; // Motor rotations per wheel rotation
+            double m_WheelRadius, m_TrackWidth; // Meters
+            double m_Mass, m_Inertia; // Kilograms and kilogram square meters about the center
+            Pose m_Pose{};
+            double m_Velocity = 0.0, m_AngularVelocity = 0.0; // Meters per second and radians per second
+            double m_LeftDistance = 0.0, m_RightDistance = 0.0; // Meters each side has rolled
+            std::vector<SideController> m_Controllers;
+
+            /**
+             * Meters per second the wheels of a side roll forward
+             */
+            double GetSideVelocity(Side side) const;
+
+            /**
+             * Rotations per meter of a side rolling forward
+             */
+            double GetShaftRotationsPerMeter(Side side) const;
+
+            void UpdateSensors();
+
+        public:
+            DriveModel(DcMotor motor, double gearRatio, double wheelRadius, double trackWidth, double mass, double inertia)
+                    : m_Motor(motor), m_GearRatio(gearRatio), m_WheelRadius(wheelRadius), m_TrackWidth(trackWidth),
+                      m_Mass(mass), m_Inertia(inertia) {}
+
+            /**
+             * Add leaders before their followers, they are updated in order
+             */
+            void AddController(lib::SimulatedSparkMax& spark, Side side);
+
+            /**
+             * Puts the robot at rest at the pose and zeroes the encoders
+             */
+            void Reset(const Pose& pose);
+
+            void Step(double period);
+
+            const Pose& GetPose() const {
+                return m_Pose;
+            }
+
+            /**
+             * Meters per second forward
+             */
+            double GetVelocity() const {
+                return m_Velocity;
+            }
+        };
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <plant/dc_motor.hpp>
+#include <plant/spark_max_model.hpp>
+
+#include <vector>
+
+#define PLANT_GRAVITY 9.81 // Meters per second squared
+#define PLANT_LIMIT_SWITCH_TRAVEL 0.05 // Motor rotations before the hard stop where a limit switch reads pressed
+
+namespace garage {
+    namespace plant {
+        /**
+         * One degree of freedom driven by Spark Maxes on a shared shaft through a gearbox. Position is in motor rotations
+         * so it is what the encoders read. Back EMF is integrated implicitly so the stiff motor stays stable at
+         * the firmware period.
+         */
+        class MechanismModel {
+        protected:
+            struct LimitSwitchBinding {
+                lib::SimulatedLimitSwitch* limitSwitch;
+                double position;
+                bool isForward;
+            };
+
+            DcMotor m_Motor;
+            double m_GearRatio; // Motor rotations per output rotation
+            double m_MinPosition, m_MaxPosition; // Motor rotations, hard stops
+            double m_Position = 0.0, m_Velocity = 0.0; // Motor rotations and radians per second
+            std::vector<SparkMaxModel> m_Controllers;
+            std::vector<LimitSwitchBinding> m_LimitSwitches;
+
+            /**
+             * Output angle in radians, zero at position zero
+             */
+            double GetOutputAngle() const;
+
+            /**
+             * Kilogram square meters at the output
+             */
+            virtual double GetInertia() const = 0;
+
+            /**
+             * Newton meters at the output, positive helps positive motion
+             */
+            virtual double GetLoadTorque() const = 0;
+
+            void UpdateSensors();
+
+        public:
+            MechanismModel(DcMotor motor, double gearRatio, double minPosition, double maxPosition)
+                    : m_Motor(motor), m_GearRatio(gearRatio), m_MinPosition(minPosition), m_MaxPosition(maxPosition) {}
+
+            virtual ~MechanismModel() = default;
+
+            /**
+             * Add leaders before their followers, they are updated in order
+             */
+            void AddController(lib::SimulatedSparkMax& spark);
+
+            void AddLimitSwitch(lib::SimulatedLimitSwitch& limitSwitch, double position, bool isForward);
+
+            /**
+             * Puts the mechanism at rest and makes the encoders read the position
+             */
+            void Reset(double position);
+
+            void Step(double period);
+
+            double GetPosition() const {
+                return m_Position;
+            }
+
+            /**
+             * RPM of the motor shaft
+             */
+            double GetVelocity() const;
+        };
+
+        class ElevatorModel : public MechanismModel {
+        protected:
+            double m_DrumRadius, m_Mass;
+
+            double GetInertia() const override;
+
+            double GetLoadTorque() const override;
+
+        public:
+            ElevatorModel(DcMotor motor, double gearRatio, double drumRadius, double mass, double minPosition, double maxPosition)
+                    : MechanismModel(motor, gearRatio, minPosition, maxPosition), m_DrumRadius(drumRadius), m_Mass(mass) {}
+        };
+
+        class ArmModel : public MechanismModel {
+        protected:
+            double m_Mass, m_CenterOfMassLength, m_AngleOffset;
+
+            double GetInertia() const override;
+
+            double GetLoadTorque() const override;
+
+        public:
+            /**
+             * The angle offset in radians is added to the output angle so its cosine is the share of the weight
+             * pulling toward position zero
+             */
+            ArmModel(DcMotor motor, double gearRatio, double mass, double centerOfMassLength, double angleOffset,
+                     double minPosition, double maxPosition)
+                    : MechanismModel(motor, gearRatio, minPosition, maxPosition),
+                      m_Mass(mass), m_CenterOfMassLength(centerOfMassLength), m_AngleOffset(angleOffset) {}
+        };
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <plant/drive_model.hpp>
+#include <plant/mechanism_model.hpp>
+
+#include <lib/clock.hpp>
+
+#include <lib/auto_routine.hpp>
+
+#include <subsystem/elevator.hpp>
+#include <subsystem/flipper.hpp>
+
+#include <memory>
+
+// Estimates, picked so holding against gravity takes about the feed forwards the subsystems use
+#define ELEVATOR_PLANT_GEAR_RATIO 15.0 // Motor rotations per drum rotation
+#define ELEVATOR_PLANT_DRUM_RADIUS 0.0286 // Meters
+#define ELEVATOR_PLANT_MASS 8.0 // Kilograms
+#define ELEVATOR_PLANT_TRAVEL 115.0 // Encoder ticks to the top hard stop
+#define FLIPPER_PLANT_GEAR_RATIO (360.0 * (FLIPPER_UPPER - FLIPPER_LOWER) / (FLIPPER_UPPER_ANGLE - FLIPPER_LOWER_ANGLE)) // Motor rotations per flipper rotation
+#define FLIPPER_PLANT_MASS 3.0 // Kilograms
+#define FLIPPER_PLANT_CENTER_OF_MASS 0.25 // Meters from the pivot
+#define DRIVE_PLANT_GEAR_RATIO (AUTO_TICKS_PER_REVOLUTION / 100.0) // Motor rotations per wheel rotation, the drive counts a hundred ticks per motor rotation
+#define DRIVE_PLANT_WHEEL_RADIUS (AUTO_WHEEL_CIRCUMFERENCE / (2.0 * M_PI)) // Meters
+#define DRIVE_PLANT_MASS 63.0 // Kilograms with bumpers and battery
+#define DRIVE_PLANT_MOMENT_OF_INERTIA 5.0 // Kilogram square meters about the center
+
+#define PLANT_PERIOD 0.001 // Seconds, how often the Spark Max firmware runs
+
+namespace garage {
+    namespace plant {
+        /**
+         * Drive, elevator and flipper of the 2019 robot, driven through the simulated devices their subsystems created
+         */
+        class RobotPlant {
+        protected:
+            std::unique_ptr<DriveModel> m_Drive;
+            std::unique_ptr<ElevatorModel> m_Elevator;
+            std::unique_ptr<ArmModel> m_Flipper;
+
+        public:
+            /**
+             * Call after the robot is initialized so the devices exist, mechanisms of disabled subsystems are skipped
+             */
+            void Initialize();
+
+            void Reset(double elevatorPosition, double flipperAngle);
+
+            void ResetDrive(const Pose& pose);
+
+            void Step(lib::Clock::Duration duration);
+
+            /**
+             * Encoder ticks, zero when there is no elevator
+             */
+            double GetElevatorPosition() const;
+
+            /**
+             * Degrees, zero when there is no flipper
+             */
+            double GetFlipperAngle() const;
+
+            /**
+             * Origin when there is no drive
+             */
+            Pose GetDrivePose() const;
+        };
+    }
+}
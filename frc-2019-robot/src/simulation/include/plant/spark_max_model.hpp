@@ -0,0 +1,43 @@
+#pragma once
+
+#include <lib/hardware/simulated_spark_max.hpp>
+
+namespace garage {
+    namespace plant {
+        /**
+         * Volts across the motor for an applied output, negative when the controller is inverted
+         */
+        double GetVoltage(lib::SimulatedSparkMax& spark, double output);
+
+        /**
+         * Stands in for the Spark Max firmware. SmartMotion runs a trapezoidal profile toward the reference and
+         * SmartVelocity ramps toward it, both at the configured max acceleration, and the resulting velocity goes
+         * into the velocity PID with the gains of the slot. Then ramp rates and limit switches are applied.
+         * S-curve is treated as trapezoidal, the firmware does not implement it either.
+         */
+        class SparkMaxModel {
+        protected:
+            lib::SimulatedSparkMax& m_Spark;
+            lib::ControlType m_ControlType = lib::ControlType::k_SmartMotion;
+            bool m_WasClosedLoop = false;
+            double m_ProfilePosition = 0.0, m_ProfileVelocity = 0.0, m_Integral = 0.0, m_LastError = 0.0, m_Output = 0.0;
+
+            double UpdateClosedLoop(double period, double position, double velocity);
+
+        public:
+            explicit SparkMaxModel(lib::SimulatedSparkMax& spark) : m_Spark(spark) {}
+
+            lib::SimulatedSparkMax& GetSpark() {
+                return m_Spark;
+            }
+
+            void Reset();
+
+            /**
+             * Runs one firmware period given what its own encoder reads, in rotations and RPM.
+             * Returns the output it applies, from -1 to 1.
+             */
+            double Update(double period, double position, double velocity);
+        };
+    }
+}
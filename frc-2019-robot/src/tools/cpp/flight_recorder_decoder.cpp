@@ -0,0 +1,96 @@
+#include <lib/flight_recorder.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cinttypes>
+
+using namespace garage;
+
+const char* GetName(const lib::FlightRecorderHeader& header, uint16_t id) {
+    return id < header.nameCount ? header.names[id] : "Unknown";
+}
+
+void WriteRecord(std::FILE* output, const lib::FlightRecorderHeader& header, const lib::FlightRecord& record) {
+    std::fprintf(output, "%" PRIu32 ",%.6f,%f,%f,%f,%f,%f,%f,%f,%d,%d,%d,%s,%d",
+                 record.sequence, record.timestamp / 1e6,
+                 record.driveForward, record.driveTurn, record.flipper, record.ballIntake,
+                 record.elevatorInput, record.outrigger, record.outriggerWheel,
+                 record.hatchIntakeDown, record.offTheBooksModeEnabled, record.isQuickTurn,
+                 GetName(header, record.activeRoutine), record.activeRoutineCount);
+    for (uint32_t i = 0; i < header.subsystemCount; i++) {
+        const lib::SubsystemTelemetry& telemetry = record.subsystems[i];
+        std::fprintf(output, ",%f,%f,%f,%f,%s,%d", telemetry.position, telemetry.velocity, telemetry.output, telemetry.current,
+                     GetName(header, telemetry.controller), telemetry.isLocked);
+    }
+    std::fputc('\n', output);
+}
+
+/**
+ * Converts a flight recorder file pulled off the robot into CSV, oldest record first.
+ * Usage: FlightRecorderDecoder <flight recorder file> [csv file, standard output by default]
+ */
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::fprintf(stderr, "Usage: %s <flight recorder file> [csv file]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    std::FILE* input = std::fopen(argv[1], "rb");
+    if (!input) {
+        std::fprintf(stderr, "Could not open %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    // Large enough that it should not live on the stack
+    static lib::FlightRecorderHeader header;
+    if (std::fread(&header, sizeof(header), 1, input) != 1) {
+        std::fprintf(stderr, "File is too short to have a header\n");
+        std::fclose(input);
+        return EXIT_FAILURE;
+    }
+    if (header.magic != FLIGHT_RECORDER_MAGIC || header.version != FLIGHT_RECORDER_VERSION ||
+        header.headerSize != sizeof(lib::FlightRecorderHeader) || header.recordSize != sizeof(lib::FlightRecord)) {
+        std::fprintf(stderr, "Not a version %d flight recorder file, or it was written with a different layout\n", FLIGHT_RECORDER_VERSION);
+        std::fclose(input);
+        return EXIT_FAILURE;
+    }
+    if (header.subsystemCount > FLIGHT_RECORDER_MAX_SUBSYSTEMS || header.nameCount > FLIGHT_RECORDER_MAX_NAMES || header.capacity == 0) {
+        std::fprintf(stderr, "Header is corrupt\n");
+        std::fclose(input);
+        return EXIT_FAILURE;
+    }
+    for (auto& name : header.names) {
+        name[FLIGHT_RECORDER_NAME_SIZE - 1] = '\0';
+    }
+    std::FILE* output = argc == 3 ? std::fopen(argv[2], "w") : stdout;
+    if (!output) {
+        std::fprintf(stderr, "Could not open %s\n", argv[2]);
+        std::fclose(input);
+        return EXIT_FAILURE;
+    }
+    /* Header row */
+    std::fprintf(output, "Sequence,Time,Drive Forward,Drive Turn,Flipper,Ball Intake,Elevator Input,Outrigger,Outrigger Wheel,"
+                         "Hatch Intake Down,Off The Books Mode,Quick Turn,Active Routine,Active Routines");
+    for (uint32_t i = 0; i < header.subsystemCount; i++) {
+        const char* name = GetName(header, header.subsystemNames[i]);
+        std::fprintf(output, ",%s Position,%s Velocity,%s Output,%s Current,%s Controller,%s Locked", name, name, name, name, name, name);
+    }
+    std::fputc('\n', output);
+    /* Records, once the ring has wrapped the oldest one is where the next would have been written */
+    const uint64_t count = header.recordCount < header.capacity ? header.recordCount : header.capacity;
+    const uint64_t first = header.recordCount < header.capacity ? 0 : header.recordCount % header.capacity;
+    lib::FlightRecord record;
+    uint64_t written = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        const uint64_t slot = (first + i) % header.capacity;
+        const long offset = static_cast<long>(sizeof(lib::FlightRecorderHeader) + slot * sizeof(lib::FlightRecord));
+        if (std::fseek(input, offset, SEEK_SET) != 0 || std::fread(&record, sizeof(record), 1, input) != 1) {
+            std::fprintf(stderr, "File ended early at record %" PRIu64 "\n", i);
+            break;
+        }
+        WriteRecord(output, header, record);
+        written++;
+    }
+    std::fprintf(stderr, "Decoded %" PRIu64 " of %" PRIu64 " recorded loops\n", written, header.recordCount);
+    std::fclose(input);
+    if (output != stdout) std::fclose(output);
+    return EXIT_SUCCESS;
+}